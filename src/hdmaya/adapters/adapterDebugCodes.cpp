@@ -78,6 +78,10 @@ TF_REGISTRY_FUNCTION(TfDebug) {
     TF_DEBUG_ENVIRONMENT_SYMBOL(
         HDMAYA_ADAPTER_MESH_UNHANDLED_PLUG_DIRTY,
         "Print information about unhandled mesh plug dirtying.");
+
+    TF_DEBUG_ENVIRONMENT_SYMBOL(
+        HDMAYA_ADAPTER_PLUGINS,
+        "Print information about loading adapter plugins.");
 }
 
 PXR_NAMESPACE_CLOSE_SCOPE
@@ -43,7 +43,8 @@ TF_DEBUG_CODES(
     HDMAYA_ADAPTER_LIGHT_SHADOWS,
     HDMAYA_ADAPTER_MATERIALS,
     HDMAYA_ADAPTER_MESH_PLUG_DIRTY,
-    HDMAYA_ADAPTER_MESH_UNHANDLED_PLUG_DIRTY);
+    HDMAYA_ADAPTER_MESH_UNHANDLED_PLUG_DIRTY,
+    HDMAYA_ADAPTER_PLUGINS);
 // clang-format on
 
 PXR_NAMESPACE_CLOSE_SCOPE
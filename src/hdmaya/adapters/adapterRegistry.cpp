@@ -26,63 +26,90 @@
 #include <pxr/base/plug/plugin.h>
 #include <pxr/base/plug/registry.h>
 #include <pxr/base/tf/instantiateSingleton.h>
+#include <pxr/base/tf/stopwatch.h>
 #include <pxr/base/tf/type.h>
 
 #include <maya/MFnDependencyNode.h>
 
+#include <hdmaya/adapters/adapterDebugCodes.h>
+
+#include <algorithm>
 #include <mutex>
 
 PXR_NAMESPACE_OPEN_SCOPE
 
+namespace {
+
+// Plugin metadata listing the Maya node types handled by an adapter type.
+constexpr auto _mayaNodeTypesKey = "mayaNodeTypes";
+
+} // namespace
+
 TF_INSTANTIATE_SINGLETON(HdMayaAdapterRegistry);
 
+template <typename C>
+C HdMayaAdapterRegistry::_GetAdapterCreator(
+    const std::unordered_map<TfToken, C, TfToken::HashFunctor>& creators,
+    const TfToken& nodeType) {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    C ret = nullptr;
+    if (!TfMapLookup(creators, nodeType, &ret) &&
+        _LoadPluginForNodeType(nodeType)) {
+        TfMapLookup(creators, nodeType, &ret);
+    }
+    return ret;
+}
+
 void HdMayaAdapterRegistry::RegisterShapeAdapter(
     const TfToken& type, ShapeAdapterCreator creator) {
-    GetInstance()._dagAdapters.insert({type, creator});
+    auto& instance = GetInstance();
+    std::lock_guard<std::recursive_mutex> lock(instance._mutex);
+    instance._dagAdapters.insert({type, creator});
 }
 
 HdMayaAdapterRegistry::ShapeAdapterCreator
 HdMayaAdapterRegistry::GetShapeAdapterCreator(const MDagPath& dag) {
     MFnDependencyNode depNode(dag.node());
-    ShapeAdapterCreator ret = nullptr;
-    TfMapLookup(
-        GetInstance()._dagAdapters, TfToken(depNode.typeName().asChar()), &ret);
-    return ret;
+    const TfToken nodeType(depNode.typeName().asChar());
+    auto& instance = GetInstance();
+    return instance._GetAdapterCreator(instance._dagAdapters, nodeType);
 }
 
 void HdMayaAdapterRegistry::RegisterLightAdapter(
     const TfToken& type, LightAdapterCreator creator) {
-    GetInstance()._lightAdapters.insert({type, creator});
+    auto& instance = GetInstance();
+    std::lock_guard<std::recursive_mutex> lock(instance._mutex);
+    instance._lightAdapters.insert({type, creator});
 }
 
 HdMayaAdapterRegistry::LightAdapterCreator
 HdMayaAdapterRegistry::GetLightAdapterCreator(const MDagPath& dag) {
     MFnDependencyNode depNode(dag.node());
-    LightAdapterCreator ret = nullptr;
-    TfMapLookup(
-        GetInstance()._lightAdapters, TfToken(depNode.typeName().asChar()),
-        &ret);
-    return ret;
+    const TfToken nodeType(depNode.typeName().asChar());
+    auto& instance = GetInstance();
+    return instance._GetAdapterCreator(instance._lightAdapters, nodeType);
 }
 
 void HdMayaAdapterRegistry::RegisterMaterialAdapter(
     const TfToken& type, MaterialAdapterCreator creator) {
-    GetInstance()._materialAdapters.insert({type, creator});
+    auto& instance = GetInstance();
+    std::lock_guard<std::recursive_mutex> lock(instance._mutex);
+    instance._materialAdapters.insert({type, creator});
 }
 
 HdMayaAdapterRegistry::MaterialAdapterCreator
 HdMayaAdapterRegistry::GetMaterialAdapterCreator(const MObject& node) {
     MFnDependencyNode depNode(node);
-    MaterialAdapterCreator ret = nullptr;
-    TfMapLookup(
-        GetInstance()._materialAdapters, TfToken(depNode.typeName().asChar()),
-        &ret);
-    return ret;
+    const TfToken nodeType(depNode.typeName().asChar());
+    auto& instance = GetInstance();
+    return instance._GetAdapterCreator(instance._materialAdapters, nodeType);
 }
 
 void HdMayaAdapterRegistry::LoadAllPlugin() {
     static std::once_flag loadAllOnce;
     std::call_once(loadAllOnce, []() {
+        auto& instance = GetInstance();
+        std::lock_guard<std::recursive_mutex> lock(instance._mutex);
         TfRegistryManager::GetInstance().SubscribeTo<HdMayaAdapterRegistry>();
 
         const TfType& adapterType = TfType::Find<HdMayaAdapter>();
@@ -105,9 +132,70 @@ void HdMayaAdapterRegistry::LoadAllPlugin() {
                     subType.GetTypeName().c_str());
                 return;
             }
-            pluginForType->Load();
+            // The built-in adapters are loaded with hdmaya.
+            if (pluginForType->IsLoaded()) { continue; }
+            const auto nodeTypes =
+                plugReg.GetDataFromPluginMetaData(subType, _mayaNodeTypesKey);
+            if (!nodeTypes.IsArrayOf<std::string>()) {
+                instance._LoadPlugin(pluginForType);
+                continue;
+            }
+            for (const auto& nodeType : nodeTypes.GetArrayOf<std::string>()) {
+                instance._deferredPlugins[TfToken(nodeType)] = pluginForType;
+            }
         }
     });
 }
 
+std::vector<std::pair<std::string, double>>
+HdMayaAdapterRegistry::GetLoadedPlugins() {
+    auto& instance = GetInstance();
+    std::lock_guard<std::recursive_mutex> lock(instance._mutex);
+    return instance._loadedPlugins;
+}
+
+std::vector<std::string> HdMayaAdapterRegistry::GetDeferredPlugins() {
+    auto& instance = GetInstance();
+    std::lock_guard<std::recursive_mutex> lock(instance._mutex);
+    std::vector<std::string> ret;
+    for (const auto& it : instance._deferredPlugins) {
+        if (std::find(ret.begin(), ret.end(), it.second->GetName()) ==
+            ret.end()) {
+            ret.push_back(it.second->GetName());
+        }
+    }
+    return ret;
+}
+
+// Called with the mutex locked.
+bool HdMayaAdapterRegistry::_LoadPluginForNodeType(const TfToken& nodeType) {
+    const auto found = _deferredPlugins.find(nodeType);
+    if (found == _deferredPlugins.end()) { return false; }
+    const auto plugin = found->second;
+    // The plugin might handle other node types as well.
+    for (auto it = _deferredPlugins.begin(); it != _deferredPlugins.end();) {
+        if (it->second == plugin) {
+            it = _deferredPlugins.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    _LoadPlugin(plugin);
+    return true;
+}
+
+void HdMayaAdapterRegistry::_LoadPlugin(const PlugPluginPtr& plugin) {
+    if (plugin->IsLoaded()) { return; }
+    TfStopwatch stopwatch;
+    stopwatch.Start();
+    plugin->Load();
+    stopwatch.Stop();
+    _loadedPlugins.emplace_back(
+        plugin->GetName(), stopwatch.GetMilliseconds());
+    TF_DEBUG(HDMAYA_ADAPTER_PLUGINS)
+        .Msg(
+            "Loaded adapter plugin %s in %.1f ms\n", plugin->GetName().c_str(),
+            stopwatch.GetMilliseconds());
+}
+
 PXR_NAMESPACE_CLOSE_SCOPE
@@ -24,6 +24,7 @@
 #ifndef __HDMAYA_ADAPTER_REGISTRY_H__
 #define __HDMAYA_ADAPTER_REGISTRY_H__
 
+#include <pxr/base/plug/plugin.h>
 #include <pxr/base/tf/singleton.h>
 #include <pxr/pxr.h>
 
@@ -34,7 +35,11 @@
 #include <hdmaya/adapters/shapeAdapter.h>
 #include <hdmaya/delegates/delegateCtx.h>
 
+#include <mutex>
+#include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 PXR_NAMESPACE_OPEN_SCOPE
 
@@ -72,11 +77,39 @@ public:
     static MaterialAdapterCreator GetMaterialAdapterCreator(
         const MObject& node);
 
-    // Find all HdMayaAdapter plugins, and load them all
+    // Find all HdMayaAdapter plugins. Plugins declaring the Maya node types
+    // their adapters handle with "mayaNodeTypes" are loaded when a node of
+    // one of those types is first looked up, the others are loaded here.
     HDMAYA_API
     static void LoadAllPlugin();
 
+    // Returns the name of each adapter plugin loaded, and the time it took
+    // to load it in milliseconds.
+    HDMAYA_API
+    static std::vector<std::pair<std::string, double>> GetLoadedPlugins();
+
+    // Returns the names of the adapter plugins waiting for a node of one of
+    // their Maya node types.
+    HDMAYA_API
+    static std::vector<std::string> GetDeferredPlugins();
+
 private:
+    template <typename C>
+    C _GetAdapterCreator(
+        const std::unordered_map<TfToken, C, TfToken::HashFunctor>& creators,
+        const TfToken& nodeType);
+    bool _LoadPluginForNodeType(const TfToken& nodeType);
+    void _LoadPlugin(const PlugPluginPtr& plugin);
+
+    // Adapter creators are looked up during Hydra's parallel sync, while
+    // plugins might be loaded. Loading a plugin registers its adapters on the
+    // same thread, so the mutex is recursive.
+    std::recursive_mutex _mutex;
+
+    std::unordered_map<TfToken, PlugPluginPtr, TfToken::HashFunctor>
+        _deferredPlugins;
+    std::vector<std::pair<std::string, double>> _loadedPlugins;
+
     std::unordered_map<TfToken, ShapeAdapterCreator, TfToken::HashFunctor>
         _dagAdapters;
     std::unordered_map<TfToken, LightAdapterCreator, TfToken::HashFunctor>
@@ -41,6 +41,8 @@ public:
         light.SetSpotCutoff(90.0f);
     }
 
+    float _GetConeAngle() override { return 90.0f; }
+
     const TfToken& LightType() const override {
         if (GetDelegate()->IsHdSt()) {
             return HdPrimTypeTokens->simpleLight;
@@ -67,6 +67,7 @@ void _TransformNodeDirty(MObject& node, MPlug& plug, void* clientData) {
             "dirtied.\n",
             adapter->GetID().GetText(), plug.partialName().asChar());
     if (plug == MayaAttrs::dagNode::visibility ||
+        plug == MayaAttrs::dagNode::hideOnPlayback ||
         plug == MayaAttrs::dagNode::intermediateObject ||
         plug == MayaAttrs::dagNode::overrideEnabled ||
         plug == MayaAttrs::dagNode::overrideVisibility) {
@@ -218,10 +219,9 @@ void HdMayaDagAdapter::CreateCallbacks() {
 
 void HdMayaDagAdapter::MarkDirty(HdDirtyBits dirtyBits) {
     if (dirtyBits != 0) {
-        GetDelegate()->GetChangeTracker().MarkRprimDirty(GetID(), dirtyBits);
+        GetDelegate()->MarkRprimDirty(GetID(), dirtyBits);
         if (IsInstanced()) {
-            GetDelegate()->GetChangeTracker().MarkInstancerDirty(
-                GetInstancerID(), dirtyBits);
+            GetDelegate()->MarkInstancerDirty(GetInstancerID(), dirtyBits);
         }
         if (dirtyBits & HdChangeTracker::DirtyVisibility) {
             _visibilityDirty = true;
@@ -311,7 +311,16 @@ HdPrimvarDescriptorVector HdMayaDagAdapter::GetInstancePrimvarDescriptors(
 }
 
 bool HdMayaDagAdapter::_GetVisibility() const {
-    return GetDagPath().isVisible();
+    if (!GetDagPath().isVisible()) { return false; }
+    if (!GetDelegate()->GetParams().playbackProfile) { return true; }
+    // Like VP2, the playback profile hides the shape if any node of its path
+    // is hidden on playback.
+    for (auto dag = GetDagPath(); dag.length() > 0; dag.pop()) {
+        if (MPlug(dag.node(), MayaAttrs::dagNode::hideOnPlayback).asBool()) {
+            return false;
+        }
+    }
+    return true;
 }
 
 VtValue HdMayaDagAdapter::GetInstancePrimvar(const TfToken& key) {
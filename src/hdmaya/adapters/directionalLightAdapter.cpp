@@ -27,8 +27,6 @@
 #include <pxr/imaging/hd/light.h>
 #include <pxr/usd/usdLux/tokens.h>
 
-#include <maya/MFnDirectionalLight.h>
-
 #include <hdmaya/adapters/adapterDebugCodes.h>
 #include <hdmaya/adapters/adapterRegistry.h>
 #include <hdmaya/adapters/lightAdapter.h>
@@ -60,6 +58,19 @@ public:
         light.SetPosition({direction[0], direction[1], direction[2], 0.0f});
     }
 
+    float GetImportance(const HdMayaViewRegion& region) override {
+        // Directional lights light the whole scene without falloff.
+        return _GetBrightness();
+    }
+
+    bool Influences(const GfRange3d& worldBounds) override { return true; }
+
+    void _ReadAttributes(const MFnDependencyNode& node) override {
+        const auto lightAnglePlug =
+            node.findPlug(MayaAttrs::directionalLight::lightAngle, true);
+        _lightAngle = lightAnglePlug.isNull() ? 0.0f : lightAnglePlug.asFloat();
+    }
+
     VtValue Get(const TfToken& key) override {
         TF_DEBUG(HDMAYA_ADAPTER_GET)
             .Msg(
@@ -68,15 +79,15 @@ public:
 
         if (key == HdLightTokens->shadowParams) {
             HdxShadowParams shadowParams;
-            MFnDirectionalLight mayaLight(GetDagPath());
-            if (!GetShadowsEnabled(mayaLight)) {
+            const auto& attributes = _GetAttributes();
+            if (!attributes.shadowsEnabled) {
                 shadowParams.enabled = false;
                 return VtValue(shadowParams);
             }
 
-            _CalculateShadowParams(mayaLight, shadowParams);
+            _CalculateShadowParams(shadowParams);
             // Use the radius as the "blur" amount, for PCSS
-            shadowParams.blur = mayaLight.shadowRadius();
+            shadowParams.blur = attributes.shadowRadius;
             return VtValue(shadowParams);
         }
 
@@ -85,17 +96,15 @@ public:
 
     VtValue GetLightParamValue(const TfToken& paramName) override {
         if (paramName == HdLightTokens->angle) {
-            MStatus status;
-            MFnDependencyNode lightNode(GetNode(), &status);
-            if (ARCH_UNLIKELY(!status)) { return VtValue(0.0f); }
-            return VtValue(
-                lightNode
-                    .findPlug(MayaAttrs::directionalLight::lightAngle, true)
-                    .asFloat());
+            _GetAttributes();
+            return VtValue(_lightAngle);
         } else {
             return HdMayaLightAdapter::GetLightParamValue(paramName);
         }
     }
+
+private:
+    float _lightAngle = 0.0f;
 };
 
 TF_REGISTRY_FUNCTION(TfType) {
@@ -25,6 +25,7 @@
 
 #include <hdmaya/hdmaya.h>
 
+#include <pxr/base/gf/math.h>
 #include <pxr/base/tf/diagnostic.h>
 #include <pxr/base/tf/type.h>
 #include <pxr/imaging/hd/light.h>
@@ -33,7 +34,6 @@
 #include <maya/MColor.h>
 #include <maya/MFnLight.h>
 #include <maya/MPlug.h>
-#include <maya/MPlugArray.h>
 #include <maya/MPoint.h>
 
 #include <maya/MNodeMessage.h>
@@ -42,6 +42,9 @@
 #include <hdmaya/adapters/constantShadowMatrix.h>
 #include <hdmaya/adapters/mayaAttrs.h>
 
+#include <algorithm>
+#include <cmath>
+
 PXR_NAMESPACE_OPEN_SCOPE
 
 TF_REGISTRY_FUNCTION(TfType) {
@@ -78,17 +81,52 @@ void _dirtyTransform(MObject& node, void* clientData) {
 
 void _dirtyParams(MObject& node, void* clientData) {
     TF_UNUSED(node);
-    auto* adapter = reinterpret_cast<HdMayaDagAdapter*>(clientData);
+    auto* adapter = reinterpret_cast<HdMayaLightAdapter*>(clientData);
+    adapter->InvalidateAttributes();
     if (adapter->IsVisible()) {
         adapter->MarkDirty(HdLight::DirtyParams | HdLight::DirtyShadowParams);
         adapter->InvalidateTransform();
     }
 }
 
-const MString defaultLightSet("defaultLightSet");
-
 } // namespace
 
+HdMayaViewRegion::HdMayaViewRegion(const GfMatrix4d& viewProjection) {
+    // Maya transforms row vectors, so the clip planes are the sums and
+    // differences of the columns.
+    const auto column = [&viewProjection](int i) -> GfVec4d {
+        return {viewProjection[0][i], viewProjection[1][i],
+                viewProjection[2][i], viewProjection[3][i]};
+    };
+    const auto x = column(0);
+    const auto y = column(1);
+    const auto z = column(2);
+    const auto w = column(3);
+    planes = {{w + x, w - x, w + y, w - y, w + z, w - z}};
+    for (auto& plane : planes) {
+        const auto length = GfVec3d(plane[0], plane[1], plane[2]).GetLength();
+        if (length > 0.0) { plane /= length; }
+    }
+    const auto inverse = viewProjection.GetInverse();
+    GfVec3d center(0.0);
+    for (auto i = 0; i < 8; ++i) {
+        points[i] = inverse.Transform(GfVec3d(
+            (i & 1) ? 1.0 : -1.0, (i & 2) ? 1.0 : -1.0, (i & 4) ? 1.0 : -1.0));
+        center += points[i];
+    }
+    points[8] = center / 8.0;
+}
+
+double HdMayaViewRegion::GetDistance(const GfVec3d& point) const {
+    auto distance = 0.0;
+    for (const auto& plane : planes) {
+        distance = std::max(
+            distance, -(plane[0] * point[0] + plane[1] * point[1] +
+                        plane[2] * point[2] + plane[3]));
+    }
+    return distance;
+}
+
 HdMayaLightAdapter::HdMayaLightAdapter(
     HdMayaDelegateCtx* delegate, const MDagPath& dag)
     : HdMayaDagAdapter(delegate->GetPrimPath(dag, true), delegate, dag) {
@@ -103,16 +141,24 @@ bool HdMayaLightAdapter::IsSupported() const {
 }
 
 void HdMayaLightAdapter::Populate() {
-    if (_isPopulated) { return; }
+    if (_isPopulated || _isCulled || !GetDelegate()->GetLightsEnabled()) {
+        return;
+    }
     if (IsVisible()) {
         GetDelegate()->InsertSprim(LightType(), GetID(), HdLight::AllDirty);
         _isPopulated = true;
+        _shadowCastersDirty = true;
     }
 }
 
 void HdMayaLightAdapter::MarkDirty(HdDirtyBits dirtyBits) {
-    if (dirtyBits != 0) {
-        GetDelegate()->GetChangeTracker().MarkSprimDirty(GetID(), dirtyBits);
+    if (dirtyBits & HdLight::DirtyTransform) { _shadowCastersDirty = true; }
+    if (dirtyBits & (HdLight::DirtyTransform | HdLight::DirtyParams |
+                     HdLight::DirtyShadowParams | HdLight::DirtyCollection)) {
+        ++_shadowVersion;
+    }
+    if (dirtyBits != 0 && _isPopulated) {
+        GetDelegate()->MarkSprimDirty(GetID(), dirtyBits);
     }
 }
 
@@ -133,49 +179,32 @@ VtValue HdMayaLightAdapter::Get(const TfToken& key) {
             GetDagPath().partialPathName().asChar());
 
     if (key == HdLightTokens->params) {
-        MFnLight mayaLight(GetDagPath());
+        const auto& attributes = _GetAttributes();
         GlfSimpleLight light;
-        const auto color = mayaLight.color();
-        const auto intensity = mayaLight.intensity();
         MPoint pt(0.0, 0.0, 0.0, 1.0);
         const auto inclusiveMatrix = GetDagPath().inclusiveMatrix();
         const auto position = pt * inclusiveMatrix;
-        // This will return zero / false if the plug is nonexistent.
-        const auto decayRate =
-            mayaLight
-                .findPlug(MayaAttrs::nonAmbientLightShapeNode::decayRate, true)
-                .asShort();
-        const auto emitDiffuse =
-            mayaLight
-                .findPlug(
-                    MayaAttrs::nonAmbientLightShapeNode::emitDiffuse, true)
-                .asBool();
-        const auto emitSpecular =
-            mayaLight
-                .findPlug(
-                    MayaAttrs::nonAmbientLightShapeNode::emitSpecular, true)
-                .asBool();
         MVector pv(0.0, 0.0, -1.0);
         const auto lightDirection = (pv * inclusiveMatrix).normal();
         light.SetHasShadow(false);
         const GfVec4f zeroColor(0.0f, 0.0f, 0.0f, 1.0f);
-        const GfVec4f lightColor(
-            color.r * intensity, color.g * intensity, color.b * intensity,
-            1.0f);
-        light.SetDiffuse(emitDiffuse ? lightColor : zeroColor);
+        const auto color =
+            attributes.color * attributes.intensity * _fadeWeight;
+        const GfVec4f lightColor(color[0], color[1], color[2], 1.0f);
+        light.SetDiffuse(attributes.emitDiffuse ? lightColor : zeroColor);
         light.SetAmbient(zeroColor);
-        light.SetSpecular(emitSpecular ? lightColor : zeroColor);
+        light.SetSpecular(attributes.emitSpecular ? lightColor : zeroColor);
         light.SetShadowResolution(1024);
         light.SetID(GetID());
         light.SetPosition(
             GfVec4f(position.x, position.y, position.z, position.w));
         light.SetSpotDirection(
             GfVec3f(lightDirection.x, lightDirection.y, lightDirection.z));
-        if (decayRate == 0) {
+        if (attributes.decayRate == 0) {
             light.SetAttenuation(GfVec3f(1.0f, 0.0f, 0.0f));
-        } else if (decayRate == 1) {
+        } else if (attributes.decayRate == 1) {
             light.SetAttenuation(GfVec3f(0.0f, 1.0f, 0.0f));
-        } else if (decayRate == 2) {
+        } else if (attributes.decayRate == 2) {
             light.SetAttenuation(GfVec3f(0.0f, 0.0f, 1.0f));
         }
         light.SetTransform(
@@ -187,6 +216,14 @@ VtValue HdMayaLightAdapter::Get(const TfToken& key) {
     } else if (key == HdLightTokens->shadowCollection) {
         HdRprimCollection coll(
             HdTokens->geometry, HdReprSelector(HdReprTokens->refined));
+        if (_shadowCastersValid) {
+            SdfPathVector rootPaths(
+                _shadowCasters.begin(), _shadowCasters.end());
+            // The path of the light matches no rprims, so no shadows are
+            // rendered without casters.
+            if (rootPaths.empty()) { rootPaths.push_back(GetID()); }
+            coll.SetRootPaths(rootPaths);
+        }
         return VtValue(coll);
     } else if (key == HdLightTokens->shadowParams) {
         HdxShadowParams shadowParams;
@@ -202,17 +239,16 @@ VtValue HdMayaLightAdapter::GetLightParamValue(const TfToken& paramName) {
             "Called HdMayaLightAdapter::GetLightParamValue(%s) - %s\n",
             paramName.GetText(), GetDagPath().partialPathName().asChar());
 
-    MFnLight light(GetDagPath());
+    const auto& attributes = _GetAttributes();
 #ifdef HDMAYA_USD_001905_BUILD
     if (paramName == HdLightTokens->color ||
         paramName == HdTokens->displayColor) {
 #else
     if (paramName == HdTokens->color) {
 #endif // HDMAYA_USD_001905_BUILD
-        const auto color = light.color();
-        return VtValue(GfVec3f(color.r, color.g, color.b));
+        return VtValue(attributes.color);
     } else if (paramName == HdLightTokens->intensity) {
-        return VtValue(light.intensity());
+        return VtValue(attributes.intensity);
     } else if (paramName == HdLightTokens->exposure) {
         return VtValue(0.0f);
     } else if (paramName == HdLightTokens->normalize) {
@@ -220,9 +256,9 @@ VtValue HdMayaLightAdapter::GetLightParamValue(const TfToken& paramName) {
     } else if (paramName == HdLightTokens->enableColorTemperature) {
         return VtValue(false);
     } else if (paramName == HdLightTokens->diffuse) {
-        return VtValue(light.lightDiffuse() ? 1.0f : 0.0f);
+        return VtValue(attributes.lightDiffuse ? 1.0f : 0.0f);
     } else if (paramName == HdLightTokens->specular) {
-        return VtValue(light.lightSpecular() ? 1.0f : 0.0f);
+        return VtValue(attributes.lightSpecular ? 1.0f : 0.0f);
     }
     return {};
 }
@@ -257,6 +293,115 @@ void HdMayaLightAdapter::CreateCallbacks() {
     HdMayaAdapter::CreateCallbacks();
 }
 
+float HdMayaLightAdapter::GetImportance(const HdMayaViewRegion& region) {
+    const auto brightness = _GetBrightness();
+    if (brightness <= 0.0f) { return 0.0f; }
+    const auto& transform = GetTransform();
+    const auto position = transform.ExtractTranslation();
+    const auto distance = region.GetDistance(position);
+    const auto decayRate = _GetAttributes().decayRate;
+    const auto importance =
+        decayRate > 0 && distance > 1.0
+            ? static_cast<float>(brightness / std::pow(distance, decayRate))
+            : brightness;
+    // Lights inside the region light it in every direction.
+    const auto coneAngle = _GetConeAngle();
+    if (coneAngle >= 180.0f || distance <= 0.0) { return importance; }
+    const auto direction =
+        transform.TransformDir(GfVec3d(0.0, 0.0, -1.0)).GetNormalized();
+    const auto cosConeAngle = std::cos(GfDegreesToRadians(coneAngle));
+    for (const auto& point : region.points) {
+        if (GfDot((point - position).GetNormalized(), direction) >=
+            cosConeAngle) {
+            return importance;
+        }
+    }
+    // Narrow cones aimed at the region might not contain any of its corners.
+    for (auto t = 1.0; t < 1.0e6; t *= 2.0) {
+        if (region.GetDistance(position + direction * t) <= 0.0) {
+            return importance;
+        }
+    }
+    return 0.0f;
+}
+
+bool HdMayaLightAdapter::UpdateSelectionFade(bool selected, float step) {
+    if (selected && _isCulled) {
+        _isCulled = false;
+        Populate();
+    }
+    const auto fadeWeight = selected ? std::min(1.0f, _fadeWeight + step)
+                                     : std::max(0.0f, _fadeWeight - step);
+    if (fadeWeight != _fadeWeight) {
+        _fadeWeight = fadeWeight;
+        MarkDirty(HdLight::DirtyParams);
+    }
+    if (!selected && _fadeWeight <= 0.0f && !_isCulled) {
+        RemovePrim();
+        _isCulled = true;
+    }
+    return _fadeWeight > 0.0f && _fadeWeight < 1.0f;
+}
+
+bool HdMayaLightAdapter::NeedsShadowCasters() {
+    return _isPopulated && _GetAttributes().shadowsEnabled;
+}
+
+void HdMayaLightAdapter::SetShadowCasters(const SdfPathVector& ids) {
+    _shadowCastersDirty = false;
+    std::set<SdfPath> shadowCasters(ids.begin(), ids.end());
+    if (_shadowCastersValid && shadowCasters == _shadowCasters) { return; }
+    _shadowCastersValid = true;
+    _shadowCasters.swap(shadowCasters);
+    MarkDirty(HdLight::DirtyCollection);
+}
+
+void HdMayaLightAdapter::SetShadowCaster(const SdfPath& id, bool isCaster) {
+    // Every rprim is in the shadow collection until the casters are set.
+    if (!_shadowCastersValid) {
+        ++_shadowVersion;
+        return;
+    }
+    const auto wasCaster = _shadowCasters.count(id) > 0;
+    if (isCaster != wasCaster) {
+        if (isCaster) {
+            _shadowCasters.insert(id);
+        } else {
+            _shadowCasters.erase(id);
+        }
+        MarkDirty(HdLight::DirtyCollection);
+    } else if (isCaster) {
+        ++_shadowVersion;
+    }
+}
+
+bool HdMayaLightAdapter::Influences(const GfRange3d& worldBounds) {
+    // Shapes without bounds are always kept, we can't tell where they are.
+    if (worldBounds.IsEmpty()) { return true; }
+    const auto brightness = _GetBrightness();
+    if (brightness <= 0.0f) { return false; }
+    const auto& transform = GetTransform();
+    const auto position = transform.ExtractTranslation();
+    const auto offset = worldBounds.GetMidpoint() - position;
+    const auto radius = worldBounds.GetSize().GetLength() * 0.5;
+    const auto distance = offset.GetLength();
+    if (distance <= radius) { return true; }
+    // Beyond this range the light is dimmer than an 8 bit color step.
+    const auto decayRate = _GetAttributes().decayRate;
+    if (decayRate > 0 &&
+        distance - radius > std::pow(256.0 * brightness, 1.0 / decayRate)) {
+        return false;
+    }
+    const auto coneAngle = _GetConeAngle();
+    if (coneAngle >= 180.0f) { return true; }
+    const auto direction =
+        transform.TransformDir(GfVec3d(0.0, 0.0, -1.0)).GetNormalized();
+    const auto angle = GfRadiansToDegrees(
+        std::acos(GfClamp(GfDot(offset / distance, direction), -1.0, 1.0)));
+    const auto spread = GfRadiansToDegrees(std::asin(radius / distance));
+    return angle - spread <= coneAngle;
+}
+
 void HdMayaLightAdapter::SetShadowProjectionMatrix(const GfMatrix4d& matrix) {
     if (!GfIsClose(_shadowProjectionMatrix, matrix, 0.0001)) {
         MarkDirty(HdLight::DirtyShadowParams);
@@ -264,36 +409,87 @@ void HdMayaLightAdapter::SetShadowProjectionMatrix(const GfMatrix4d& matrix) {
     }
 }
 
-void HdMayaLightAdapter::_CalculateShadowParams(
-    MFnLight& light, HdxShadowParams& params) {
+const HdMayaLightAdapter::_Attributes& HdMayaLightAdapter::_GetAttributes() {
+    if (!_attributesDirty) { return _attributes; }
+    _attributesDirty = false;
+    _attributes = _Attributes();
+    MStatus status;
+    MFnLight light(GetDagPath(), &status);
+    if (ARCH_UNLIKELY(!status)) { return _attributes; }
+    const auto color = light.color();
+    _attributes.color = GfVec3f(color.r, color.g, color.b);
+    _attributes.intensity = light.intensity();
+    _attributes.lightDiffuse = light.lightDiffuse();
+    _attributes.lightSpecular = light.lightSpecular();
+    // The plugs are null if the light type does not have the attribute.
+    const auto decayRatePlug =
+        light.findPlug(MayaAttrs::nonAmbientLightShapeNode::decayRate, true);
+    if (!decayRatePlug.isNull()) {
+        _attributes.decayRate = decayRatePlug.asShort();
+    }
+    const auto emitDiffusePlug = light.findPlug(
+        MayaAttrs::nonAmbientLightShapeNode::emitDiffuse, true);
+    if (!emitDiffusePlug.isNull()) {
+        _attributes.emitDiffuse = emitDiffusePlug.asBool();
+    }
+    const auto emitSpecularPlug = light.findPlug(
+        MayaAttrs::nonAmbientLightShapeNode::emitSpecular, true);
+    if (!emitSpecularPlug.isNull()) {
+        _attributes.emitSpecular = emitSpecularPlug.asBool();
+    }
+    if (GetNode().hasFn(MFn::kNonExtendedLight)) {
+        MFnNonExtendedLight nonExtendedLight(GetNode());
+        _attributes.shadowsEnabled = GetShadowsEnabled(nonExtendedLight);
+        _attributes.shadowRadius = nonExtendedLight.shadowRadius();
+        const auto dmapResolutionPlug = light.findPlug(
+            MayaAttrs::nonExtendedLightShapeNode::dmapResolution, true);
+        if (!dmapResolutionPlug.isNull()) {
+            _attributes.dmapResolution = dmapResolutionPlug.asInt();
+        }
+        const auto dmapBiasPlug = light.findPlug(
+            MayaAttrs::nonExtendedLightShapeNode::dmapBias, true);
+        if (!dmapBiasPlug.isNull()) {
+            _attributes.dmapBias = dmapBiasPlug.asFloat();
+        }
+        const auto dmapFilterSizePlug = light.findPlug(
+            MayaAttrs::nonExtendedLightShapeNode::dmapFilterSize, true);
+        if (!dmapFilterSizePlug.isNull()) {
+            _attributes.dmapFilterSize = dmapFilterSizePlug.asInt();
+        }
+    }
+    _ReadAttributes(light);
+    return _attributes;
+}
+
+float HdMayaLightAdapter::_GetBrightness() {
+    const auto& attributes = _GetAttributes();
+    if (!attributes.emitDiffuse && !attributes.emitSpecular) { return 0.0f; }
+    const auto& color = attributes.color;
+    return attributes.intensity * std::max({color[0], color[1], color[2]});
+}
+
+void HdMayaLightAdapter::_CalculateShadowParams(HdxShadowParams& params) {
     TF_DEBUG(HDMAYA_ADAPTER_LIGHT_SHADOWS)
         .Msg(
             "Called HdMayaLightAdapter::_CalculateShadowParams - %s\n",
             GetDagPath().partialPathName().asChar());
 
-    const auto dmapResolutionPlug = light.findPlug(
-        MayaAttrs::nonExtendedLightShapeNode::dmapResolution, true);
-    const auto dmapBiasPlug =
-        light.findPlug(MayaAttrs::nonExtendedLightShapeNode::dmapBias, true);
-    const auto dmapFilterSizePlug = light.findPlug(
-        MayaAttrs::nonExtendedLightShapeNode::dmapFilterSize, true);
-
+    const auto& attributes = _GetAttributes();
+    const auto maximumShadowMapResolution =
+        GetDelegate()->GetParams().maximumShadowMapResolution;
     params.enabled = true;
-    params.resolution =
-        dmapResolutionPlug.isNull()
-            ? GetDelegate()->GetParams().maximumShadowMapResolution
-            : std::min(
-                  GetDelegate()->GetParams().maximumShadowMapResolution,
-                  dmapResolutionPlug.asInt());
+    params.resolution = attributes.dmapResolution < 0
+                            ? maximumShadowMapResolution
+                            : std::min(
+                                  maximumShadowMapResolution,
+                                  attributes.dmapResolution);
     params.shadowMatrix =
         boost::static_pointer_cast<HdxShadowMatrixComputation>(
             boost::make_shared<HdMayaConstantShadowMatrix>(
                 GetTransform() * _shadowProjectionMatrix));
-    params.bias = dmapBiasPlug.isNull() ? -0.001 : -dmapBiasPlug.asFloat();
-    params.blur = dmapFilterSizePlug.isNull()
-                      ? 0.0
-                      : (static_cast<double>(dmapFilterSizePlug.asInt())) /
-                            static_cast<double>(params.resolution);
+    params.bias = -attributes.dmapBias;
+    params.blur = static_cast<double>(attributes.dmapFilterSize) /
+                  static_cast<double>(params.resolution);
 
     if (TfDebug::IsEnabled(HDMAYA_ADAPTER_LIGHT_SHADOWS)) {
         std::cout << "Resulting HdxShadowParams:\n";
@@ -305,26 +501,8 @@ bool HdMayaLightAdapter::_GetVisibility() const {
     if (!GetDagPath().isVisible()) { return false; }
     // Shapes are not part of the default light set.
     if (!GetNode().hasFn(MFn::kLight)) { return true; }
-    MStatus status;
-    MFnDependencyNode node(GetDagPath().transform(), &status);
-    if (ARCH_UNLIKELY(!status)) { return true; }
-    auto p = node.findPlug(MayaAttrs::dagNode::instObjGroups, true);
-    if (ARCH_UNLIKELY(p.isNull())) { return true; }
-    const auto numElements = p.numElements();
-    MPlugArray conns;
-    for (auto i = decltype(numElements){0}; i < numElements; ++i) {
-        auto ep = p[i]; // == elementByPhysicalIndex
-        if (!ep.connectedTo(conns, false, true) || conns.length() < 1) {
-            continue;
-        }
-        const auto numConns = conns.length();
-        for (auto j = decltype(numConns){0}; j < numConns; ++j) {
-            MFnDependencyNode otherNode(conns[j].node(), &status);
-            if (!status) { continue; }
-            if (otherNode.name() == defaultLightSet) { return true; }
-        }
-    }
-    return false;
+    return GetDelegate()->GetLightSetIndex().IsMember(
+        GetDagPath().transform());
 }
 
 PXR_NAMESPACE_CLOSE_SCOPE
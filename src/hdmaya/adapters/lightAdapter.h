@@ -27,6 +27,7 @@
 #include <pxr/pxr.h>
 
 #include <pxr/base/gf/frustum.h>
+#include <pxr/base/gf/range3d.h>
 
 #include <pxr/imaging/glf/simpleLight.h>
 #include <pxr/imaging/hdx/simpleLightTask.h>
@@ -37,8 +38,27 @@
 #include <hdmaya/adapters/dagAdapter.h>
 #include <pxr/imaging/hd/light.h>
 
+#include <array>
+#include <set>
+
 PXR_NAMESPACE_OPEN_SCOPE
 
+/// \brief Region seen by the camera, used to estimate the importance of
+/// lights.
+struct HdMayaViewRegion {
+    HDMAYA_API
+    HdMayaViewRegion(const GfMatrix4d& viewProjection);
+
+    /// Returns the distance of a point from the region, 0 if it's inside.
+    HDMAYA_API
+    double GetDistance(const GfVec3d& point) const;
+
+    /// Planes of the frustum pointing inwards.
+    std::array<GfVec4d, 6> planes;
+    /// Corners and center of the frustum.
+    std::array<GfVec3d, 9> points;
+};
+
 class HdMayaLightAdapter : public HdMayaDagAdapter {
 public:
     inline bool GetShadowsEnabled(MFnNonExtendedLight& light) {
@@ -69,16 +89,115 @@ public:
     virtual void CreateCallbacks() override;
     HDMAYA_API
     void SetShadowProjectionMatrix(const GfMatrix4d& matrix);
+    /// Marks the snapshot of the light attributes out of date, so it is read
+    /// again the next time a parameter is queried.
+    void InvalidateAttributes() {
+        _attributesDirty = true;
+        _shadowCastersDirty = true;
+    }
+    /// \brief Estimates how much the light contributes to the visible region.
+    ///
+    /// \param region Region seen by the camera.
+    /// \return Importance of the light, 0 if it does not light the region.
+    HDMAYA_API
+    virtual float GetImportance(const HdMayaViewRegion& region);
+    /// \brief Fades the light in or out after it was picked or dropped by the
+    /// light selection of the scene delegate.
+    ///
+    /// Dropped lights are removed from the render index once they faded out.
+    ///
+    /// \param selected True if the light was picked.
+    /// \param step Change of the light's weight.
+    /// \return True if the light is still fading.
+    HDMAYA_API
+    bool UpdateSelectionFade(bool selected, float step);
+    /// Returns true if the light was removed by the light selection.
+    bool IsCulled() const { return _isCulled; }
+    /// Returns true if the light renders shadows, so its shadow casters have
+    /// to be kept up to date.
+    HDMAYA_API
+    bool NeedsShadowCasters();
+    /// Returns true if every shape has to be tested against the light again,
+    /// after the light moved or its attributes changed.
+    bool ShadowCastersDirty() const { return _shadowCastersDirty; }
+    /// Replaces the shapes casting shadows from the light.
+    HDMAYA_API
+    void SetShadowCasters(const SdfPathVector& ids);
+    /// \brief Updates a single shape after it changed.
+    ///
+    /// Adds or removes the shape from the shadow casters, and bumps the
+    /// shadow version if the shape was or is a caster.
+    ///
+    /// \param id Id of the shape.
+    /// \param isCaster True if the shape casts shadows from the light.
+    HDMAYA_API
+    void SetShadowCaster(const SdfPath& id, bool isCaster);
+    /// Returns a version that is bumped whenever the shadow map of the light
+    /// has to be rendered again.
+    size_t GetShadowVersion() const { return _shadowVersion; }
+    /// Returns the number of shapes casting shadows from the light.
+    size_t GetShadowCasterCount() const { return _shadowCasters.size(); }
+    /// \brief Tests if the light reaches a shape.
+    ///
+    /// \param worldBounds Bounding box of the shape in world space.
+    /// \return True if the shape might be lit by the light.
+    HDMAYA_API
+    virtual bool Influences(const GfRange3d& worldBounds);
 
 protected:
+    /// Snapshot of the scalar attributes shared by the light types.
+    struct _Attributes {
+        GfVec3f color = {1.0f, 1.0f, 1.0f};
+        float intensity = 1.0f;
+        float shadowRadius = 0.0f;
+        // Negated when used as the shadow bias.
+        float dmapBias = 0.001f;
+        // Negative if the light has no depth map attributes.
+        int dmapResolution = -1;
+        int dmapFilterSize = 0;
+        short decayRate = 0;
+        bool emitDiffuse = false;
+        bool emitSpecular = false;
+        bool lightDiffuse = false;
+        bool lightSpecular = false;
+        bool shadowsEnabled = false;
+    };
+
+    /// Returns the snapshot of the light attributes, reading them again if
+    /// the light node was dirtied since the last call.
+    HDMAYA_API
+    const _Attributes& _GetAttributes();
+    /// Reads the attributes specific to a light type, called when the
+    /// snapshot is refreshed.
+    HDMAYA_API
+    virtual void _ReadAttributes(const MFnDependencyNode& node) {}
+    /// Returns the half angle of the light cone in degrees, 180 if the light
+    /// emits in all directions.
+    HDMAYA_API
+    virtual float _GetConeAngle() { return 180.0f; }
+    /// Returns the intensity of the brightest color channel.
+    HDMAYA_API
+    float _GetBrightness();
     HDMAYA_API
     virtual void _CalculateLightParams(GlfSimpleLight& light) {}
     HDMAYA_API
-    void _CalculateShadowParams(MFnLight& light, HdxShadowParams& params);
+    void _CalculateShadowParams(HdxShadowParams& params);
     HDMAYA_API
     bool _GetVisibility() const override;
 
     GfMatrix4d _shadowProjectionMatrix;
+
+private:
+    _Attributes _attributes;
+    std::set<SdfPath> _shadowCasters;
+    size_t _shadowVersion = 0;
+    float _fadeWeight = 1.0f;
+    bool _attributesDirty = true;
+    bool _isCulled = false;
+    bool _shadowCastersDirty = true;
+    // False until the shadow casters are set, the shadow collection contains
+    // every rprim until then.
+    bool _shadowCastersValid = false;
 };
 
 using HdMayaLightAdapterPtr = std::shared_ptr<HdMayaLightAdapter>;
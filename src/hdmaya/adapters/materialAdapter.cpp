@@ -160,7 +160,7 @@ bool HdMayaMaterialAdapter::HasType(const TfToken& typeId) const {
 }
 
 void HdMayaMaterialAdapter::MarkDirty(HdDirtyBits dirtyBits) {
-    GetDelegate()->GetChangeTracker().MarkSprimDirty(GetID(), dirtyBits);
+    GetDelegate()->MarkSprimDirty(GetID(), dirtyBits);
 }
 
 void HdMayaMaterialAdapter::RemovePrim() {
@@ -419,13 +419,13 @@ private:
                 auto regLock = resourceRegistry->RegisterTextureResource(
                     textureKey, &textureInstance);
                 if (textureInstance.IsFirstInstance()) {
-                    auto textureResource = GetFileTextureResource(
-                        connectedFileObj, filePath,
-                        GetDelegate()->GetParams().textureMemoryPerTexture);
+                    auto textureResource =
+                        _GetFileTextureResource(connectedFileObj, filePath);
                     _textureResources[paramName] = textureResource;
                     textureInstance.SetValue(textureResource);
                 } else {
                     _textureResources[paramName] = textureInstance.GetValue();
+                    _TrackTexture(filePath, _textureResources[paramName]);
                 }
 #ifdef HDMAYA_USD_001901_BUILD
                 if (GlfIsSupportedUdimTexture(filePath)) {
@@ -511,20 +511,60 @@ private:
         const MObject& fileObj, const TfToken& filePath) {
         auto hash = filePath.Hash();
         const auto wrapping = GetFileTextureWrappingParams(fileObj);
-        boost::hash_combine(
-            hash, GetDelegate()->GetParams().textureMemoryPerTexture);
+        const auto textureMemory = _GetTextureMemory(filePath);
+        // Materials reusing the resource of another material are only seen
+        // here, but they have to be synced again when the memory target of
+        // the texture changes too.
+        GetDelegate()->GetTextureBudget().TrackTexture(
+            filePath, GetID(), HdTextureResourceSharedPtr());
+        boost::hash_combine(hash, textureMemory);
         boost::hash_combine(hash, std::get<0>(wrapping));
         boost::hash_combine(hash, std::get<1>(wrapping));
+        boost::hash_combine(hash, GetFileTextureCacheVersion());
+        // The placeholder and the loaded texture need different IDs, so
+        // Hydra requests the texture again once the loading finished.
+        // Evicted textures are not loaded.
+        boost::hash_combine(
+            hash, textureMemory != 0 &&
+                      GetDelegate()->GetTextureLoader().RequestTexture(
+                          filePath, static_cast<int>(textureMemory), GetID()));
         return HdTextureResource::ID(hash);
     }
 
+    inline size_t _GetTextureMemory(const TfToken& filePath) {
+        return GetDelegate()->GetTextureBudget().GetTextureMemory(
+            filePath, GetDelegate()->GetParams().textureMemoryPerTexture);
+    }
+
+    inline HdTextureResourceSharedPtr _GetFileTextureResource(
+        const MObject& fileObj, const TfToken& filePath) {
+        auto& textureLoader = GetDelegate()->GetTextureLoader();
+        const auto textureMemory = _GetTextureMemory(filePath);
+        // Evicted textures are bound as the placeholder.
+        auto ret = textureMemory == 0
+                       ? textureLoader.GetPlaceholder()
+                       : textureLoader.GetTextureResource(
+                             filePath, GetFileTextureWrappingParams(fileObj),
+                             static_cast<int>(textureMemory), GetID());
+        _TrackTexture(filePath, ret);
+        return ret;
+    }
+
+    inline void _TrackTexture(
+        const TfToken& filePath, const HdTextureResourceSharedPtr& resource) {
+        GetDelegate()->GetTextureBudget().TrackTexture(
+            filePath, GetID(),
+            resource == GetDelegate()->GetTextureLoader().GetPlaceholder()
+                ? HdTextureResourceSharedPtr()
+                : resource);
+    }
+
     HdTextureResourceSharedPtr GetTextureResource(
         const TfToken& paramName) override {
         auto fileObj = GetConnectedFileNode(_surfaceShader, paramName);
         if (fileObj == MObject::kNullObj) { return {}; }
-        return GetFileTextureResource(
-            fileObj, GetFileTexturePath(MFnDependencyNode(fileObj)),
-            GetDelegate()->GetParams().textureMemoryPerTexture);
+        return _GetFileTextureResource(
+            fileObj, GetFileTexturePath(MFnDependencyNode(fileObj)));
     }
 
     VtValue GetMaterialResource() override {
@@ -39,6 +39,8 @@
 
 #include <hdmaya/utils.h>
 
+#include <boost/functional/hash.hpp>
+
 #include <mutex>
 
 PXR_NAMESPACE_OPEN_SCOPE
@@ -93,7 +95,8 @@ const std::vector<TfToken>& GetPreferredOutputNames(
     return defaultPreferredOutputNames;
 }
 
-TfToken GetOutputName(const HdMaterialNode& material, SdfValueTypeName type) {
+TfToken ComputeOutputName(
+    const HdMaterialNode& material, SdfValueTypeName type) {
     TF_DEBUG(HDMAYA_ADAPTER_MATERIALS)
         .Msg(
             "GetOutputName(%s - %s, %s)\n", material.path.GetText(),
@@ -174,6 +177,37 @@ TfToken GetOutputName(const HdMaterialNode& material, SdfValueTypeName type) {
     return HdMayaAdapterTokens->result;
 }
 
+// The output name only depends on the shader identifier and the requested
+// type, so we memoize the result of the (expensive) Sdr registry queries.
+using _OutputNameKey = std::pair<TfToken, SdfValueTypeName>;
+
+struct _OutputNameKeyHash {
+    size_t operator()(const _OutputNameKey& key) const {
+        size_t hash = 0;
+        boost::hash_combine(hash, key.first);
+        boost::hash_combine(hash, key.second);
+        return hash;
+    }
+};
+
+std::mutex _outputNames_mutex;
+std::unordered_map<_OutputNameKey, TfToken, _OutputNameKeyHash> _outputNames;
+
+TfToken GetOutputName(const HdMaterialNode& material, SdfValueTypeName type) {
+    const _OutputNameKey key{material.identifier, type};
+    {
+        std::lock_guard<std::mutex> lock(_outputNames_mutex);
+        const auto it = _outputNames.find(key);
+        if (it != _outputNames.end()) { return it->second; }
+    }
+    // We don't hold the lock while querying the registry, worst case two
+    // threads compute the same name.
+    const auto outputName = ComputeOutputName(material, type);
+    std::lock_guard<std::mutex> lock(_outputNames_mutex);
+    _outputNames.emplace(key, outputName);
+    return outputName;
+}
+
 std::mutex _previewShaderParams_mutex;
 bool _previewShaderParams_initialized = false;
 HdMayaShaderParams _previewShaderParams;
@@ -515,7 +549,12 @@ HdMayaShaderParam::HdMayaShaderParam(
 
 HdMayaMaterialNetworkConverter::HdMayaMaterialNetworkConverter(
     HdMaterialNetwork& network, const SdfPath& prefix)
-    : _network(network), _prefix(prefix) {}
+    : _network(network), _prefix(prefix) {
+    _nodeIndices.reserve(_network.nodes.size());
+    for (size_t i = 0, n = _network.nodes.size(); i < n; ++i) {
+        _nodeIndices.emplace(_network.nodes[i].path, i);
+    }
+}
 
 HdMaterialNode* HdMayaMaterialNetworkConverter::GetMaterial(
     const MObject& mayaNode) {
@@ -531,12 +570,10 @@ HdMaterialNode* HdMayaMaterialNetworkConverter::GetMaterial(
     std::replace(usdPathStr.begin(), usdPathStr.end(), ':', '_');
     const auto materialPath = _prefix.AppendPath(SdfPath(usdPathStr));
 
-    auto findResult = std::find_if(
-        _network.nodes.begin(), _network.nodes.end(),
-        [&materialPath](const HdMaterialNode& m) -> bool {
-            return m.path == materialPath;
-        });
-    if (findResult != _network.nodes.end()) { return &(*findResult); }
+    const auto findResult = _nodeIndices.find(materialPath);
+    if (findResult != _nodeIndices.end()) {
+        return &_network.nodes[findResult->second];
+    }
 
     auto* nodeConverter = HdMayaMaterialNodeConverter::GetNodeConverter(
         TfToken(node.typeName().asChar()));
@@ -579,6 +616,7 @@ HdMaterialNode* HdMayaMaterialNetworkConverter::GetMaterial(
             }
         }
     }
+    _nodeIndices.emplace(materialPath, _network.nodes.size());
     _network.nodes.push_back(material);
     return &_network.nodes.back();
 }
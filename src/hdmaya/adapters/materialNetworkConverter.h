@@ -36,6 +36,8 @@
 #include <maya/MFnDependencyNode.h>
 #include <maya/MObject.h>
 
+#include <unordered_map>
+
 PXR_NAMESPACE_OPEN_SCOPE
 
 struct HdMayaShaderParam {
@@ -164,6 +166,8 @@ public:
 private:
     HdMaterialNetwork& _network;
     const SdfPath& _prefix;
+    /// Index of the converted nodes in _network.nodes, keyed by their path.
+    std::unordered_map<SdfPath, size_t, SdfPath::Hash> _nodeIndices;
 };
 
 PXR_NAMESPACE_CLOSE_SCOPE
@@ -55,6 +55,7 @@ MObject intermediateObject;
 MObject instObjGroups;
 MObject overrideEnabled;
 MObject overrideVisibility;
+MObject hideOnPlayback;
 
 } // namespace dagNode
 
@@ -87,6 +88,12 @@ namespace directionalLight {
 MObject lightAngle;
 }
 
+namespace geometryShape {
+
+MObject castsShadows;
+
+} // namespace geometryShape
+
 namespace surfaceShape {
 
 MObject doubleSided;
@@ -126,6 +133,7 @@ MObject fileTextureName;
 MObject fileTextureNamePattern;
 MObject uvTilingMode;
 MObject uvCoord;
+MObject useFrameExtension;
 MObject wrapU;
 MObject wrapV;
 MObject mirrorU;
@@ -187,6 +195,7 @@ MStatus initialize() {
         SET_ATTR_OBJ(instObjGroups);
         SET_ATTR_OBJ(overrideEnabled);
         SET_ATTR_OBJ(overrideVisibility);
+        SET_ATTR_OBJ(hideOnPlayback);
     }
 
     {
@@ -218,6 +227,12 @@ MStatus initialize() {
         SET_ATTR_OBJ(lightAngle);
     }
 
+    {
+        SET_NODE_CLASS(geometryShape);
+
+        SET_ATTR_OBJ(castsShadows);
+    }
+
     {
         SET_NODE_CLASS(surfaceShape);
 
@@ -254,6 +269,7 @@ MStatus initialize() {
         SET_ATTR_OBJ(fileTextureNamePattern);
         SET_ATTR_OBJ(uvTilingMode);
         SET_ATTR_OBJ(uvCoord);
+        SET_ATTR_OBJ(useFrameExtension);
         SET_ATTR_OBJ(wrapU);
         SET_ATTR_OBJ(wrapV);
         SET_ATTR_OBJ(mirrorU);
@@ -54,6 +54,7 @@ extern MObject intermediateObject;
 extern MObject instObjGroups;
 extern MObject overrideEnabled;
 extern MObject overrideVisibility;
+extern MObject hideOnPlayback;
 
 } // namespace dagNode
 
@@ -90,9 +91,16 @@ extern MObject lightAngle;
 
 } // namespace directionalLight
 
-namespace surfaceShape {
+namespace geometryShape {
 
 using namespace dagNode;
+extern MObject castsShadows;
+
+} // namespace geometryShape
+
+namespace surfaceShape {
+
+using namespace geometryShape;
 extern MObject doubleSided;
 
 } // namespace surfaceShape
@@ -134,6 +142,7 @@ extern MObject fileTextureName;
 extern MObject fileTextureNamePattern;
 extern MObject uvTilingMode;
 extern MObject uvCoord;
+extern MObject useFrameExtension;
 extern MObject wrapU;
 extern MObject wrapV;
 extern MObject mirrorU;
@@ -175,6 +175,16 @@ public:
         return VtValue(ret);
     }
 
+    bool GetRawPoints(const GfVec3f*& points, size_t& count) override {
+        MStatus status;
+        MFnMesh mesh(GetDagPath(), &status);
+        if (ARCH_UNLIKELY(!status)) { return false; }
+        points = reinterpret_cast<const GfVec3f*>(mesh.getRawPoints(&status));
+        if (ARCH_UNLIKELY(!status)) { return false; }
+        count = static_cast<size_t>(mesh.numVertices());
+        return true;
+    }
+
     VtValue Get(const TfToken& key) override {
         TF_DEBUG(HDMAYA_ADAPTER_GET)
             .Msg(
@@ -253,16 +263,14 @@ public:
 
     HdDisplayStyle GetDisplayStyle() override {
 #if MAYA_APP_VERSION >= 2019
-        MStatus status;
-        MFnDependencyNode node(GetNode(), &status);
-        if (ARCH_UNLIKELY(!status)) { return {0, false, false}; }
-        const auto displaySmoothMesh =
-            node.findPlug(MayaAttrs::mesh::displaySmoothMesh, true).asShort();
-        if (displaySmoothMesh == 0) { return {0, false, false}; }
-        const auto smoothLevel = std::min(
-            MAX_SMOOTH_LEVEL,
-            std::max(
-                0, node.findPlug(MayaAttrs::mesh::smoothLevel, true).asInt()));
+        _UpdateAttributes();
+        if (_displaySmoothMesh == 0) { return {0, false, false}; }
+        auto smoothLevel =
+            std::min(MAX_SMOOTH_LEVEL, std::max(0, _smoothLevel));
+        const auto& params = GetDelegate()->GetParams();
+        if (params.playbackProfile) {
+            smoothLevel = std::min(smoothLevel, params.playbackRefineLevel);
+        }
         return {smoothLevel, false, false};
 #else
         return {0, false, false};
@@ -358,12 +366,8 @@ public:
     }
 
     bool GetDoubleSided() override {
-        MFnMesh mesh(GetDagPath());
-        auto p = mesh.findPlug(MayaAttrs::mesh::doubleSided, true);
-        if (ARCH_UNLIKELY(p.isNull())) { return true; }
-        bool doubleSided = true;
-        p.getValue(doubleSided);
-        return doubleSided;
+        _UpdateAttributes();
+        return _doubleSided;
     }
 
     bool HasType(const TfToken& typeId) const override {
@@ -371,9 +375,36 @@ public:
     }
 
 private:
+    // Reads the display attributes in one pass, after one of them was
+    // dirtied.
+    void _UpdateAttributes() {
+        if (!_attributesDirty) { return; }
+        _attributesDirty = false;
+        MStatus status;
+        MFnDependencyNode node(GetNode(), &status);
+        if (ARCH_UNLIKELY(!status)) { return; }
+        const auto doubleSidedPlug =
+            node.findPlug(MayaAttrs::mesh::doubleSided, true);
+        _doubleSided =
+            doubleSidedPlug.isNull() ? true : doubleSidedPlug.asBool();
+        _displaySmoothMesh =
+            node.findPlug(MayaAttrs::mesh::displaySmoothMesh, true).asShort();
+        _smoothLevel =
+            node.findPlug(MayaAttrs::mesh::smoothLevel, true).asInt();
+    }
+
     static void NodeDirtiedCallback(
         MObject& node, MPlug& plug, void* clientData) {
         auto* adapter = reinterpret_cast<HdMayaMeshAdapter*>(clientData);
+        if (plug == MayaAttrs::mesh::castsShadows) {
+            adapter->MarkCastsShadowsDirty();
+            return;
+        }
+        if (plug == MayaAttrs::mesh::doubleSided ||
+            plug == MayaAttrs::mesh::displaySmoothMesh ||
+            plug == MayaAttrs::mesh::smoothLevel) {
+            adapter->_attributesDirty = true;
+        }
         for (const auto& it : _dirtyBits) {
             if (it.first == plug) {
                 adapter->MarkDirty(it.second);
@@ -441,6 +472,10 @@ private:
     // To work around this, we register these callbacks specially, and only
     // remove them if the underlying node is currently valid.
     MCallbackIdArray _buggyCallbacks;
+    int _smoothLevel = 0;
+    short _displaySmoothMesh = 0;
+    bool _doubleSided = true;
+    bool _attributesDirty = true;
 };
 
 TF_REGISTRY_FUNCTION(TfType) {
@@ -167,6 +167,10 @@ private:
     static void NodeDirtiedCallback(
         MObject& node, MPlug& plug, void* clientData) {
         auto* adapter = reinterpret_cast<HdMayaNurbsCurveAdapter*>(clientData);
+        if (plug == MayaAttrs::nurbsCurve::castsShadows) {
+            adapter->MarkCastsShadowsDirty();
+            return;
+        }
         for (const auto& it : _dirtyBits) {
             if (it.first == plug) {
                 adapter->MarkDirty(it.second);
@@ -27,8 +27,6 @@
 #include <pxr/imaging/hd/light.h>
 #include <pxr/usd/usdLux/tokens.h>
 
-#include <maya/MFnPointLight.h>
-
 #include <hdmaya/adapters/adapterDebugCodes.h>
 #include <hdmaya/adapters/adapterRegistry.h>
 #include <hdmaya/adapters/lightAdapter.h>
@@ -56,12 +54,11 @@ public:
                 "Called HdMayaPointLightAdapter::GetLightParamValue(%s) - %s\n",
                 paramName.GetText(), GetDagPath().partialPathName().asChar());
 
-        MFnPointLight light(GetDagPath());
+        const auto& attributes = _GetAttributes();
         if (paramName == UsdLuxTokens->radius) {
-            const float radius = light.shadowRadius();
-            return VtValue(radius);
+            return VtValue(attributes.shadowRadius);
         } else if (paramName == UsdLuxTokens->treatAsPoint) {
-            const bool treatAsPoint = (light.shadowRadius() == 0.0);
+            const bool treatAsPoint = (attributes.shadowRadius == 0.0f);
             return VtValue(treatAsPoint);
         }
         return HdMayaLightAdapter::GetLightParamValue(paramName);
@@ -23,8 +23,10 @@
 //
 #include <hdmaya/adapters/shapeAdapter.h>
 
+#include <pxr/base/gf/bbox3d.h>
 #include <pxr/base/tf/type.h>
 
+#include <maya/MFnDependencyNode.h>
 #include <maya/MPlug.h>
 #include <maya/MPlugArray.h>
 
@@ -37,6 +39,18 @@ TF_REGISTRY_FUNCTION(TfType) {
     TfType::Define<HdMayaShapeAdapter, TfType::Bases<HdMayaDagAdapter> >();
 }
 
+namespace {
+
+// Dirty bits that change how the shape is rendered into shadow maps.
+constexpr HdDirtyBits _shadowDirtyBits =
+    HdChangeTracker::DirtyPoints | HdChangeTracker::DirtyExtent |
+    HdChangeTracker::DirtyTransform | HdChangeTracker::DirtyVisibility |
+    HdChangeTracker::DirtyTopology | HdChangeTracker::DirtySubdivTags |
+    HdChangeTracker::DirtyDisplayStyle | HdChangeTracker::DirtyInstancer |
+    HdChangeTracker::DirtyInstanceIndex | HdChangeTracker::DirtyRepr;
+
+} // namespace
+
 HdMayaShapeAdapter::HdMayaShapeAdapter(
     const SdfPath& id, HdMayaDelegateCtx* delegate, const MDagPath& dagPath)
     : HdMayaDagAdapter(id, delegate, dagPath) {
@@ -79,6 +93,12 @@ PxOsdSubdivTags HdMayaShapeAdapter::GetSubdivTags() { return {}; }
 void HdMayaShapeAdapter::MarkDirty(HdDirtyBits dirtyBits) {
     HdMayaDagAdapter::MarkDirty(dirtyBits);
     if (dirtyBits & HdChangeTracker::DirtyPoints) { _extentDirty = true; }
+    if (dirtyBits & _shadowDirtyBits) {
+        GetDelegate()->ShadowCasterChanged(GetID());
+    }
+    if (dirtyBits & HdChangeTracker::DirtyMaterialId) {
+        GetDelegate()->MaterialAssignmentChanged(GetID());
+    }
 }
 
 MObject HdMayaShapeAdapter::GetMaterial() {
@@ -114,19 +134,45 @@ const GfRange3d& HdMayaShapeAdapter::GetExtent() {
     return _extent;
 }
 
+GfRange3d HdMayaShapeAdapter::GetWorldBounds() {
+    return GfBBox3d(GetExtent(), GetTransform()).ComputeAlignedRange();
+}
+
+bool HdMayaShapeAdapter::GetCastsShadows() {
+    if (_castsShadowsDirty) {
+        _castsShadowsDirty = false;
+        MStatus status;
+        MFnDependencyNode node(GetNode(), &status);
+        if (ARCH_UNLIKELY(!status)) { return _castsShadows; }
+        const auto plug =
+            node.findPlug(MayaAttrs::geometryShape::castsShadows, true);
+        _castsShadows = plug.isNull() || plug.asBool();
+    }
+    return _castsShadows;
+}
+
+void HdMayaShapeAdapter::MarkCastsShadowsDirty() {
+    _castsShadowsDirty = true;
+    GetDelegate()->ShadowCasterChanged(GetID());
+}
+
 TfToken HdMayaShapeAdapter::GetRenderTag() const { return HdTokens->geometry; }
 
+int HdMayaShapeAdapter::GetSelectedInstance(const MDagPath& selectedDag) {
+    return IsInstanced() ? static_cast<int>(selectedDag.instanceNumber())
+                         : -1;
+}
+
 void HdMayaShapeAdapter::PopulateSelectedPaths(
     const MDagPath& selectedDag, SdfPathVector& selectedSdfPaths,
     std::unordered_set<SdfPath, SdfPath::Hash>& selectedMasters,
     const HdSelectionSharedPtr& selection) {
     VtIntArray indices(1);
-    if (IsInstanced()) {
-        indices[0] = selectedDag.instanceNumber();
+    indices[0] = GetSelectedInstance(selectedDag);
+    if (indices[0] >= 0) {
         selection->AddInstance(HdSelection::HighlightModeSelect, _id, indices);
-        if (selectedMasters.find(_id) == selectedMasters.end()) {
+        if (selectedMasters.insert(_id).second) {
             selectedSdfPaths.push_back(_id);
-            selectedMasters.insert(_id);
         }
     } else {
         selection->AddRprim(HdSelection::HighlightModeSelect, _id);
@@ -69,9 +69,47 @@ public:
     HDMAYA_API
     const GfRange3d& GetExtent();
 
+    /// Returns the bounding box of the shape in world space.
+    HDMAYA_API
+    GfRange3d GetWorldBounds();
+
+    /// Returns true if the shape casts shadows.
+    HDMAYA_API
+    bool GetCastsShadows();
+
+    /// Marks the shadow casting state out of date, after the castsShadows
+    /// attribute of the shape was dirtied.
+    HDMAYA_API
+    void MarkCastsShadowsDirty();
+
+    /// \brief Returns the points of the shape as stored by Maya.
+    ///
+    /// The data is only valid until Maya evaluates the shape again, and can
+    /// be read from other threads until then.
+    ///
+    /// \param points Set to the first point.
+    /// \param count Set to the number of points.
+    /// \return False if the shape doesn't store its points as GfVec3fs.
+    HDMAYA_API
+    virtual bool GetRawPoints(const GfVec3f*& points, size_t& count) {
+        return false;
+    }
+
     HDMAYA_API
     virtual TfToken GetRenderTag() const;
 
+    /// \brief Returns the instance of the rprim selected by a dag path.
+    ///
+    /// \param selectedDag Selected dag path of the shape.
+    /// \return The instance index, or -1 if the whole rprim is selected.
+    HDMAYA_API
+    virtual int GetSelectedInstance(const MDagPath& selectedDag);
+
+    /// \brief Adds the rprim selected by a dag path to the selection.
+    ///
+    /// \deprecated The scene delegate caches the result of
+    ///  GetSelectedInstance and no longer calls this, so subclasses have to
+    ///  override GetSelectedInstance instead.
     HDMAYA_API
     virtual void PopulateSelectedPaths(
         const MDagPath& selectedDag, SdfPathVector& selectedSdfPaths,
@@ -85,6 +123,8 @@ protected:
 private:
     GfRange3d _extent;
     bool _extentDirty;
+    bool _castsShadows = true;
+    bool _castsShadowsDirty = true;
 };
 
 using HdMayaShapeAdapterPtr = std::shared_ptr<HdMayaShapeAdapter>;
@@ -44,37 +44,6 @@
 
 PXR_NAMESPACE_OPEN_SCOPE
 
-namespace {
-void GetSpotCutoffAndSoftness(
-    MFnSpotLight& mayaLight, float& cutoffOut, float& softnessOut) {
-    // Divided by two.
-    auto coneAngle =
-        static_cast<float>(GfRadiansToDegrees(mayaLight.coneAngle())) * 0.5f;
-    auto penumbraAngle =
-        static_cast<float>(GfRadiansToDegrees(mayaLight.penumbraAngle()));
-    cutoffOut = coneAngle + penumbraAngle;
-    softnessOut = cutoffOut == 0 ? 0 : penumbraAngle / cutoffOut;
-}
-
-float GetSpotCutoff(MFnSpotLight& mayaLight) {
-    float cutoff;
-    float softness;
-    GetSpotCutoffAndSoftness(mayaLight, cutoff, softness);
-    return cutoff;
-}
-
-float GetSpotSoftness(MFnSpotLight& mayaLight) {
-    float cutoff;
-    float softness;
-    GetSpotCutoffAndSoftness(mayaLight, cutoff, softness);
-    return softness;
-}
-
-float GetSpotFalloff(MFnSpotLight& mayaLight) {
-    return static_cast<float>(mayaLight.dropOff());
-}
-} // namespace
-
 class HdMayaSpotLightAdapter : public HdMayaLightAdapter {
 public:
     HdMayaSpotLightAdapter(HdMayaDelegateCtx* delegate, const MDagPath& dag)
@@ -89,14 +58,31 @@ public:
     }
 
 protected:
-    void _CalculateLightParams(GlfSimpleLight& light) override {
+    void _ReadAttributes(const MFnDependencyNode& node) override {
         MStatus status;
-        MFnSpotLight mayaLight(GetDagPath(), &status);
-        if (TF_VERIFY(status)) {
-            light.SetHasShadow(true);
-            light.SetSpotCutoff(GetSpotCutoff(mayaLight));
-            light.SetSpotFalloff(GetSpotFalloff(mayaLight));
-        }
+        MFnSpotLight mayaLight(node.object(), &status);
+        if (!TF_VERIFY(status)) { return; }
+        // Divided by two.
+        const auto coneAngle =
+            static_cast<float>(GfRadiansToDegrees(mayaLight.coneAngle())) *
+            0.5f;
+        const auto penumbraAngle =
+            static_cast<float>(GfRadiansToDegrees(mayaLight.penumbraAngle()));
+        _cutoff = coneAngle + penumbraAngle;
+        _softness = _cutoff == 0 ? 0 : penumbraAngle / _cutoff;
+        _falloff = static_cast<float>(mayaLight.dropOff());
+    }
+
+    float _GetConeAngle() override {
+        _GetAttributes();
+        return _cutoff;
+    }
+
+    void _CalculateLightParams(GlfSimpleLight& light) override {
+        _GetAttributes();
+        light.SetHasShadow(true);
+        light.SetSpotCutoff(_cutoff);
+        light.SetSpotFalloff(_falloff);
     }
 
     VtValue Get(const TfToken& key) override {
@@ -107,15 +93,15 @@ protected:
 
         if (key == HdLightTokens->shadowParams) {
             HdxShadowParams shadowParams;
-            MFnSpotLight mayaLight(GetDagPath());
-            if (!GetShadowsEnabled(mayaLight)) {
+            const auto& attributes = _GetAttributes();
+            if (!attributes.shadowsEnabled) {
                 shadowParams.enabled = false;
                 return VtValue(shadowParams);
             }
 
-            _CalculateShadowParams(mayaLight, shadowParams);
+            _CalculateShadowParams(shadowParams);
             // Use the radius as the "blur" amount, for PCSS
-            shadowParams.blur = mayaLight.shadowRadius();
+            shadowParams.blur = attributes.shadowRadius;
             return VtValue(shadowParams);
         }
 
@@ -128,25 +114,26 @@ protected:
                 "Called HdMayaSpotLightAdapter::GetLightParamValue(%s) - %s\n",
                 paramName.GetText(), GetDagPath().partialPathName().asChar());
 
-        MStatus status;
-        MFnSpotLight light(GetDagPath(), &status);
-        if (TF_VERIFY(status)) {
-            if (paramName == UsdLuxTokens->radius) {
-                const float radius = light.shadowRadius();
-                return VtValue(radius);
-            } else if (paramName == UsdLuxTokens->treatAsPoint) {
-                const bool treatAsPoint = (light.shadowRadius() == 0.0);
-                return VtValue(treatAsPoint);
-            } else if (paramName == UsdLuxTokens->shapingConeAngle) {
-                return VtValue(GetSpotCutoff(light));
-            } else if (paramName == UsdLuxTokens->shapingConeSoftness) {
-                return VtValue(GetSpotSoftness(light));
-            } else if (paramName == UsdLuxTokens->shapingFocus) {
-                return VtValue(GetSpotFalloff(light));
-            }
+        const auto& attributes = _GetAttributes();
+        if (paramName == UsdLuxTokens->radius) {
+            return VtValue(attributes.shadowRadius);
+        } else if (paramName == UsdLuxTokens->treatAsPoint) {
+            const bool treatAsPoint = (attributes.shadowRadius == 0.0f);
+            return VtValue(treatAsPoint);
+        } else if (paramName == UsdLuxTokens->shapingConeAngle) {
+            return VtValue(_cutoff);
+        } else if (paramName == UsdLuxTokens->shapingConeSoftness) {
+            return VtValue(_softness);
+        } else if (paramName == UsdLuxTokens->shapingFocus) {
+            return VtValue(_falloff);
         }
         return HdMayaLightAdapter::GetLightParamValue(paramName);
     }
+
+private:
+    float _cutoff = 0.0f;
+    float _softness = 0.0f;
+    float _falloff = 0.0f;
 };
 
 TF_REGISTRY_FUNCTION(TfType) {
@@ -38,4 +38,11 @@ HdMayaDelegate::HdMayaDelegate(const InitData& initData)
 
 void HdMayaDelegate::SetParams(const HdMayaParams& params) { _params = params; }
 
+void HdMayaDelegate::ApplyDeferredEdits() {
+    // The edits defer themselves again if the render index is still busy.
+    auto edits = std::move(_deferredEdits);
+    _deferredEdits.clear();
+    for (auto& edit : edits) { edit(); }
+}
+
 PXR_NAMESPACE_CLOSE_SCOPE
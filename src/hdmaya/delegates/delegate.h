@@ -40,7 +40,9 @@
 #include <maya/MDrawContext.h>
 #include <maya/MSelectionList.h>
 
+#include <functional>
 #include <memory>
+#include <vector>
 
 #include <hdmaya/api.h>
 #include <hdmaya/delegates/params.h>
@@ -84,6 +86,22 @@ public:
     virtual void Populate() = 0;
     virtual void PreFrame(const MHWRender::MDrawContext& context) {}
     virtual void PostFrame() {}
+    /// \brief Returns true if the delegate has no work left in the
+    ///  background that requires further redraws.
+    virtual bool IsConverged() { return true; }
+    /// \brief Returns a version that changes whenever the shadow maps have
+    ///  to be rendered again for the lights and shapes of the delegate.
+    ///
+    /// \param version Set to the shadow version of the delegate.
+    /// \return False if the delegate does not track its shadows, so the
+    ///  shadow maps are rendered every frame.
+    virtual bool GetShadowVersion(size_t& version) { return false; }
+    /// \brief Returns the number of frames the rendered data lags behind
+    ///  Maya, when extracting the data is pipelined with rendering.
+    virtual int GetPipelineLatency() { return 0; }
+    /// \brief Returns the number of prims drawn from data staged by the
+    ///  pipeline.
+    virtual int GetPipelineStagedCount() { return 0; }
 
     HDMAYA_API
     virtual void SetParams(const HdMayaParams& params);
@@ -105,13 +123,47 @@ public:
     virtual bool SupportsUfeSelection() { return false; }
 #endif // HDMAYA_UFE_BUILD
 
-    void SetLightsEnabled(const bool enabled) { _lightsEnabled = enabled; }
+    /// \brief Enables or disables the scene lights, for example when
+    ///  switching to and from Maya's default light.
+    ///
+    /// Can be called on a populated delegate, the lights are toggled without
+    /// touching the other prims.
+    virtual void SetLightsEnabled(const bool enabled) {
+        _lightsEnabled = enabled;
+    }
     bool GetLightsEnabled() { return _lightsEnabled; }
 
     inline HdEngine& GetEngine() { return _engine; }
     inline HdxTaskController* GetTaskController() { return _taskController; }
 
+    /// \brief Sets a function returning true while another thread executes
+    ///  tasks of the render index.
+    ///
+    /// Prims are not inserted, removed or dirtied in the meantime, the edits
+    /// are deferred until ApplyDeferredEdits is called.
+    void SetRenderIndexBusyCallback(const std::function<bool()>& callback) {
+        _renderIndexBusyCallback = callback;
+    }
+    /// \brief Applies the render index edits deferred while the render index
+    ///  was busy, in the order they were made.
+    HDMAYA_API
+    void ApplyDeferredEdits();
+
+protected:
+    /// \brief Returns true if a render index edit has to be deferred, because
+    ///  the render index is busy or earlier edits are still deferred.
+    bool _IsEditDeferred() const {
+        return !_deferredEdits.empty() ||
+               (_renderIndexBusyCallback && _renderIndexBusyCallback());
+    }
+    /// \brief Defers a render index edit until ApplyDeferredEdits is called.
+    void _DeferEdit(std::function<void()>&& edit) {
+        _deferredEdits.push_back(std::move(edit));
+    }
+
 private:
+    std::function<bool()> _renderIndexBusyCallback;
+    std::vector<std::function<void()>> _deferredEdits;
     HdMayaParams _params;
 
     // Note that because there may not be a 1-to-1 relationship between
@@ -87,6 +87,12 @@ HdMayaDelegateCtx::HdMayaDelegateCtx(const InitData& initData)
 void HdMayaDelegateCtx::InsertRprim(
     const TfToken& typeId, const SdfPath& id, HdDirtyBits initialBits,
     const SdfPath& instancerId) {
+    if (_IsEditDeferred()) {
+        _DeferEdit([this, typeId, id, initialBits, instancerId]() {
+            InsertRprim(typeId, id, initialBits, instancerId);
+        });
+        return;
+    }
     if (!instancerId.IsEmpty()) {
         GetRenderIndex().InsertInstancer(this, instancerId);
         GetChangeTracker().InstancerInserted(id);
@@ -97,22 +103,68 @@ void HdMayaDelegateCtx::InsertRprim(
 
 void HdMayaDelegateCtx::InsertSprim(
     const TfToken& typeId, const SdfPath& id, HdDirtyBits initialBits) {
+    if (_IsEditDeferred()) {
+        _DeferEdit([this, typeId, id, initialBits]() {
+            InsertSprim(typeId, id, initialBits);
+        });
+        return;
+    }
     GetRenderIndex().InsertSprim(typeId, this, id);
     GetChangeTracker().SprimInserted(id, initialBits);
 }
 
 void HdMayaDelegateCtx::RemoveRprim(const SdfPath& id) {
+    if (_IsEditDeferred()) {
+        _DeferEdit([this, id]() { RemoveRprim(id); });
+        return;
+    }
     GetRenderIndex().RemoveRprim(id);
 }
 
 void HdMayaDelegateCtx::RemoveSprim(const TfToken& typeId, const SdfPath& id) {
+    if (_IsEditDeferred()) {
+        _DeferEdit([this, typeId, id]() { RemoveSprim(typeId, id); });
+        return;
+    }
     GetRenderIndex().RemoveSprim(typeId, id);
 }
 
 void HdMayaDelegateCtx::RemoveInstancer(const SdfPath& id) {
+    if (_IsEditDeferred()) {
+        _DeferEdit([this, id]() { RemoveInstancer(id); });
+        return;
+    }
     GetRenderIndex().RemoveInstancer(id);
 }
 
+void HdMayaDelegateCtx::MarkRprimDirty(
+    const SdfPath& id, HdDirtyBits dirtyBits) {
+    if (_IsEditDeferred()) {
+        _DeferEdit([this, id, dirtyBits]() { MarkRprimDirty(id, dirtyBits); });
+        return;
+    }
+    GetChangeTracker().MarkRprimDirty(id, dirtyBits);
+}
+
+void HdMayaDelegateCtx::MarkSprimDirty(
+    const SdfPath& id, HdDirtyBits dirtyBits) {
+    if (_IsEditDeferred()) {
+        _DeferEdit([this, id, dirtyBits]() { MarkSprimDirty(id, dirtyBits); });
+        return;
+    }
+    GetChangeTracker().MarkSprimDirty(id, dirtyBits);
+}
+
+void HdMayaDelegateCtx::MarkInstancerDirty(
+    const SdfPath& id, HdDirtyBits dirtyBits) {
+    if (_IsEditDeferred()) {
+        _DeferEdit(
+            [this, id, dirtyBits]() { MarkInstancerDirty(id, dirtyBits); });
+        return;
+    }
+    GetChangeTracker().MarkInstancerDirty(id, dirtyBits);
+}
+
 SdfPath HdMayaDelegateCtx::GetPrimPath(const MDagPath& dg, bool isLight) {
     if (isLight) {
         return _GetPrimPath(_sprimPath, dg);
@@ -34,6 +34,9 @@
 #include <maya/MDagPath.h>
 
 #include <hdmaya/delegates/delegate.h>
+#include <hdmaya/lightSetIndex.h>
+#include <hdmaya/textureBudget.h>
+#include <hdmaya/textureLoader.h>
 
 PXR_NAMESPACE_OPEN_SCOPE
 
@@ -66,6 +69,18 @@ public:
     void RemoveSprim(const TfToken& typeId, const SdfPath& id);
     HDMAYA_API
     void RemoveInstancer(const SdfPath& id);
+    /// \brief Marks an rprim dirty, after the render index edits deferred
+    ///  before.
+    HDMAYA_API
+    void MarkRprimDirty(const SdfPath& id, HdDirtyBits dirtyBits);
+    /// \brief Marks an sprim dirty, after the render index edits deferred
+    ///  before.
+    HDMAYA_API
+    void MarkSprimDirty(const SdfPath& id, HdDirtyBits dirtyBits);
+    /// \brief Marks an instancer dirty, after the render index edits
+    ///  deferred before.
+    HDMAYA_API
+    void MarkInstancerDirty(const SdfPath& id, HdDirtyBits dirtyBits);
     virtual void RemoveAdapter(const SdfPath& id) {}
     virtual void RecreateAdapter(const SdfPath& id, const MObject& obj) {}
     virtual void RecreateAdapterOnIdle(const SdfPath& id, const MObject& obj) {}
@@ -74,12 +89,30 @@ public:
     ///
     /// \param id Id of the Material that changed its tag.
     virtual void MaterialTagChanged(const SdfPath& id) {}
+    /// \brief Notifies the scene delegate when a shape is assigned another
+    ///  material.
+    ///
+    /// \param id Id of the Rprim that changed its material.
+    virtual void MaterialAssignmentChanged(const SdfPath& id) {}
+    /// \brief Notifies the scene delegate when a shape changes in a way that
+    ///  affects the shadow maps.
+    ///
+    /// \param id Id of the Rprim that has to be culled against lights again.
+    virtual void ShadowCasterChanged(const SdfPath& id) {}
     HDMAYA_API
     SdfPath GetPrimPath(const MDagPath& dg, bool isLight);
     HDMAYA_API
     SdfPath GetMaterialPath(const MObject& obj);
+    HdMayaTextureLoader& GetTextureLoader() { return _textureLoader; }
+    HdMayaTextureBudget& GetTextureBudget() { return _textureBudget; }
+    HdMayaLightSetIndex& GetLightSetIndex() { return _lightSetIndex; }
+
+    bool IsConverged() override { return !_textureLoader.HasPendingLoads(); }
 
 private:
+    HdMayaTextureLoader _textureLoader;
+    HdMayaTextureBudget _textureBudget;
+    HdMayaLightSetIndex _lightSetIndex;
     SdfPath _rprimPath;
     SdfPath _sprimPath;
     SdfPath _materialPath;
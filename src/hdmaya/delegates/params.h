@@ -32,9 +32,23 @@ PXR_NAMESPACE_OPEN_SCOPE
 
 struct HdMayaParams {
     int textureMemoryPerTexture = 4 * 1024 * 1024;
+    /// Total texture memory of a delegate in bytes, 0 means unlimited.
+    size_t textureMemoryBudget = 0;
     int maximumShadowMapResolution = 2048;
+    /// Maximum number of lights picked for HdSt, 0 means all lights.
+    int maximumLights = 0;
+    /// Lights less important than this are not picked for HdSt.
+    float lightImportanceThreshold = 0.0f;
     bool displaySmoothMeshes = true;
     bool enableMotionSamples = false;
+    /// Extract the points of deforming shapes while the previous frame
+    /// renders, adding a frame of latency. Only used during playback.
+    bool pipelinedPlayback = false;
+    /// Hide shapes with hideOnPlayback set, cap the refine level of meshes
+    /// and suspend texture loading. Only used during playback.
+    bool playbackProfile = false;
+    /// Maximum refine level of meshes with the playback profile.
+    int playbackRefineLevel = 0;
 };
 
 PXR_NAMESPACE_CLOSE_SCOPE
@@ -45,7 +45,9 @@
 #include <maya/MDGMessage.h>
 #include <maya/MDagPath.h>
 #include <maya/MDagPathArray.h>
+#include <maya/MEventMessage.h>
 #include <maya/MItDag.h>
+#include <maya/MItSelectionList.h>
 #include <maya/MMatrixArray.h>
 #include <maya/MObjectHandle.h>
 #include <maya/MString.h>
@@ -57,6 +59,11 @@
 #include <hdmaya/utils.h>
 #include <pxr/imaging/hd/light.h>
 
+#include <boost/functional/hash.hpp>
+
+#include <algorithm>
+#include <tuple>
+
 PXR_NAMESPACE_OPEN_SCOPE
 
 namespace {
@@ -68,8 +75,6 @@ void _nodeAdded(MObject& obj, void* clientData) {
     delegate->NodeAdded(obj);
 }
 
-const MString defaultLightSet("defaultLightSet");
-
 void _connectionChanged(
     MPlug& srcPlug, MPlug& destPlug, bool made, void* clientData) {
     TF_UNUSED(made);
@@ -78,21 +83,23 @@ void _connectionChanged(
     const auto destObj = destPlug.node();
     if (!destObj.hasFn(MFn::kSet)) { return; }
     if (srcPlug != MayaAttrs::dagNode::instObjGroups) { return; }
-    MStatus status;
-    MFnDependencyNode destNode(destObj, &status);
-    if (ARCH_UNLIKELY(!status)) { return; }
-    if (destNode.name() != defaultLightSet) { return; }
     auto* delegate = reinterpret_cast<HdMayaSceneDelegate*>(clientData);
-    MDagPath dag;
-    status = MDagPath::getAPathTo(srcObj, dag);
-    if (ARCH_UNLIKELY(!status)) { return; }
-    unsigned int shapesBelow = 0;
-    dag.numberOfShapesDirectlyBelow(shapesBelow);
-    for (auto i = decltype(shapesBelow){0}; i < shapesBelow; ++i) {
-        auto dagCopy = dag;
-        dagCopy.extendToShapeDirectlyBelow(i);
-        delegate->UpdateLightVisibility(dagCopy);
-    }
+    auto& lightSetIndex = delegate->GetLightSetIndex();
+    if (!lightSetIndex.IsDefaultLightSet(destObj)) { return; }
+    // The connection might not be finished yet, so the membership is checked
+    // in PreFrame.
+    lightSetIndex.MarkDirty(srcObj);
+}
+
+// Lights fade in and out over four frames when they are picked or dropped.
+constexpr float _lightFadeStep = 0.25f;
+// Picked lights are only dropped for clearly more important lights, so lights
+// of similar importance don't swap every frame.
+constexpr float _pickedLightBias = 1.25f;
+
+void _workspaceChanged(void* clientData) {
+    auto* delegate = reinterpret_cast<HdMayaSceneDelegate*>(clientData);
+    delegate->RefreshFileTextures();
 }
 
 template <typename T, typename F>
@@ -156,8 +163,21 @@ inline void _MapAdapter(F f, const M0& m0, const M&... m) {
     _MapAdapter<T>(f, m...);
 }
 
+GfRange3d _ComputeExtent(const VtVec3fArray& points) {
+    GfRange3d extent;
+    for (const auto& point : points) { extent.UnionWith(GfVec3d(point)); }
+    return extent;
+}
+
 } // namespace
 
+size_t HdMayaSceneDelegate::_DagPathHash::operator()(
+    const MDagPath& dag) const {
+    size_t hash = MObjectHandle(dag.node()).hashCode();
+    boost::hash_combine(hash, dag.instanceNumber());
+    return hash;
+}
+
 TF_DEFINE_PRIVATE_TOKENS(
     _tokens,
     (HdMayaSceneDelegate)((FallbackMaterial, "__fallback_material__")));
@@ -181,6 +201,7 @@ HdMayaSceneDelegate::HdMayaSceneDelegate(const InitData& initData)
           initData.delegateID.AppendChild(_tokens->FallbackMaterial)) {}
 
 HdMayaSceneDelegate::~HdMayaSceneDelegate() {
+    _pointsExtraction.wait();
     for (auto callback : _callbacks) { MMessage::removeCallback(callback); }
     _MapAdapter<HdMayaAdapter>(
         [](HdMayaAdapter* a) { a->RemoveCallbacks(); }, _shapeAdapters,
@@ -203,6 +224,11 @@ void HdMayaSceneDelegate::Populate() {
     if (status) { _callbacks.push_back(id); }
     id = MDGMessage::addConnectionCallback(_connectionChanged, this, &status);
     if (status) { _callbacks.push_back(id); }
+    // Relative texture paths are resolved against the project root.
+    ClearFileTextureCaches();
+    id = MEventMessage::addEventCallback(
+        "workspaceChanged", _workspaceChanged, this, &status);
+    if (status) { _callbacks.push_back(id); }
 
     // Adding fallback material sprim to the render index.
     if (renderIndex.IsSprimTypeSupported(HdPrimTypeTokens->material)) {
@@ -212,6 +238,39 @@ void HdMayaSceneDelegate::Populate() {
 }
 
 void HdMayaSceneDelegate::PreFrame(const MHWRender::MDrawContext& context) {
+    auto& textureLoader = GetTextureLoader();
+    auto& textureBudget = GetTextureBudget();
+    const auto prioritizeTextures = textureLoader.HasPendingLoads();
+    const auto updateTextureBudget = textureBudget.NeedsUpdate();
+    if (prioritizeTextures || updateTextureBudget) {
+        _MapAdapter<HdMayaShapeAdapter>(
+            [&](HdMayaShapeAdapter* a) {
+                if (!a->IsVisible(false)) { return; }
+                const auto materialId = GetMaterialPath(a->GetMaterial());
+                if (prioritizeTextures) {
+                    textureLoader.SetPriority(
+                        materialId, HdMayaTextureLoader::PriorityVisible);
+                }
+                if (updateTextureBudget) { textureBudget.MarkUsed(materialId); }
+            },
+            _shapeAdapters);
+    }
+    auto dirtyMaterials = textureLoader.ProcessCompletedLoads();
+    if (updateTextureBudget) {
+        const auto budgetMaterials =
+            textureBudget.Update(GetParams().textureMemoryPerTexture);
+        dirtyMaterials.insert(
+            dirtyMaterials.end(), budgetMaterials.begin(),
+            budgetMaterials.end());
+    }
+    for (const auto& id : dirtyMaterials) {
+        _FindAdapter<HdMayaMaterialAdapter>(
+            id,
+            [](HdMayaMaterialAdapter* a) {
+                a->MarkDirty(HdMaterial::AllDirty);
+            },
+            _materialAdapters);
+    }
     if (!_materialTagsChanged.empty()) {
         if (IsHdSt()) {
             for (const auto& id : _materialTagsChanged) {
@@ -235,6 +294,18 @@ void HdMayaSceneDelegate::PreFrame(const MHWRender::MDrawContext& context) {
         }
         _materialTagsChanged.clear();
     }
+    if (!_materialAssignmentsChanged.empty()) { _UpdateSelectedMaterials(); }
+    for (const auto& transform : GetLightSetIndex().Update()) {
+        MDagPath dag;
+        if (!MDagPath::getAPathTo(transform, dag)) { continue; }
+        unsigned int shapesBelow = 0;
+        dag.numberOfShapesDirectlyBelow(shapesBelow);
+        for (auto i = decltype(shapesBelow){0}; i < shapesBelow; ++i) {
+            auto dagCopy = dag;
+            dagCopy.extendToShapeDirectlyBelow(i);
+            UpdateLightVisibility(dagCopy);
+        }
+    }
     if (!_addedNodes.empty()) {
         for (const auto& obj : _addedNodes) {
             if (obj.isNull()) { continue; }
@@ -294,7 +365,13 @@ void HdMayaSceneDelegate::PreFrame(const MHWRender::MDrawContext& context) {
         }
         _adaptersToRebuild.clear();
     }
-    if (!IsHdSt()) { return; }
+    _UpdatePointsPipeline();
+    if (!IsHdSt()) {
+        _shadowCastersChanged.clear();
+        return;
+    }
+    _SelectLights(context);
+    _UpdateShadowCasters();
     constexpr auto considerAllSceneLights =
         MHWRender::MDrawContext::kFilteredIgnoreLightLimit;
     MStatus status;
@@ -329,6 +406,238 @@ void HdMayaSceneDelegate::PreFrame(const MHWRender::MDrawContext& context) {
     }
 }
 
+void HdMayaSceneDelegate::PostFrame() {
+    // The raw points are only valid until Maya evaluates the next frame.
+    _pointsExtraction.wait();
+}
+
+int HdMayaSceneDelegate::GetPipelineLatency() {
+    return _pipelineActive ? 1 : 0;
+}
+
+int HdMayaSceneDelegate::GetPipelineStagedCount() {
+    return static_cast<int>(_stagedShapes[0].size());
+}
+
+void HdMayaSceneDelegate::_UpdatePointsPipeline() {
+    auto& frontShapes = _stagedShapes[0];
+    auto& backShapes = _stagedShapes[1];
+    auto markShapesDirty = [this](const AdapterMap<_StagedShape>& shapes) {
+        for (const auto& it : shapes) {
+            const auto dirtyBits = it.second.dirtyBits;
+            _FindAdapter<HdMayaShapeAdapter>(
+                it.first,
+                [dirtyBits](HdMayaShapeAdapter* a) { a->MarkDirty(dirtyBits); },
+                _shapeAdapters);
+        }
+    };
+    if (!GetParams().pipelinedPlayback) {
+        if (!_pipelineActive) { return; }
+        // The shapes are read from Maya again, without latency. The shapes
+        // of the back buffer were never synced, so they are dirtied as well.
+        markShapesDirty(frontShapes);
+        markShapesDirty(backShapes);
+        frontShapes.clear();
+        backShapes.clear();
+        _pipelineActive = false;
+        return;
+    }
+    _pipelineActive = true;
+    // Every shape Maya moved or deformed since the last frame is staged and
+    // cleaned in the change tracker, so Hydra keeps drawing all of them with
+    // the data of the last frame until the next swap. Shapes with a new
+    // topology are read from Maya right away, as the staged points would not
+    // match it.
+    constexpr HdDirtyBits stagedBits = HdChangeTracker::DirtyPoints |
+                                       HdChangeTracker::DirtyTransform |
+                                       HdChangeTracker::DirtyExtent;
+    auto& changeTracker = GetChangeTracker();
+    std::vector<std::pair<HdMayaShapeAdapter*, HdDirtyBits>> changed;
+    std::vector<SdfPath> unstaged;
+    _MapAdapter<HdMayaShapeAdapter>(
+        [&](HdMayaShapeAdapter* a) {
+            const auto& id = a->GetID();
+            const auto dirtyBits = changeTracker.GetRprimDirtyBits(id);
+            if (dirtyBits & HdChangeTracker::DirtyTopology) {
+                unstaged.push_back(id);
+            } else if (dirtyBits & stagedBits) {
+                changed.emplace_back(a, dirtyBits & stagedBits);
+                changeTracker.MarkRprimClean(id, dirtyBits & ~stagedBits);
+            }
+        },
+        _shapeAdapters);
+    std::swap(frontShapes, backShapes);
+    // Shapes that stopped changing are read from Maya again.
+    markShapesDirty(backShapes);
+    backShapes.clear();
+    for (const auto& id : unstaged) { frontShapes.erase(id); }
+    markShapesDirty(frontShapes);
+    for (const auto& it : changed) {
+        auto* a = it.first;
+        // Nodes are not moved when the map grows, so the tasks can write
+        // their shapes while others are added.
+        auto& staged = backShapes[a->GetID()];
+        staged.dirtyBits = it.second;
+        staged.transform = a->GetTransform();
+        if (!(staged.dirtyBits & HdChangeTracker::DirtyPoints)) {
+            staged.extent = a->GetExtent();
+            continue;
+        }
+        staged.dirtyBits |= HdChangeTracker::DirtyExtent;
+        // Maya can only be read on the main thread, so the shapes that don't
+        // expose their raw points are converted here.
+        const GfVec3f* points = nullptr;
+        size_t count = 0;
+        if (a->GetRawPoints(points, count)) {
+            _pointsExtraction.run([points, count, &staged]() {
+                staged.points.assign(points, points + count);
+                staged.extent = _ComputeExtent(staged.points);
+            });
+        } else {
+            const auto value = a->Get(HdTokens->points);
+            if (value.IsHolding<VtVec3fArray>()) {
+                staged.points = value.UncheckedGet<VtVec3fArray>();
+            }
+            _pointsExtraction.run([&staged]() {
+                staged.extent = _ComputeExtent(staged.points);
+            });
+        }
+    }
+}
+
+bool HdMayaSceneDelegate::IsConverged() {
+    return HdMayaDelegateCtx::IsConverged() && !_lightsFading;
+}
+
+bool HdMayaSceneDelegate::GetShadowVersion(size_t& version) {
+    // Shadow casters are only tracked for HdSt.
+    if (!IsHdSt()) { return false; }
+    version = 0;
+    _MapAdapter<HdMayaLightAdapter>(
+        [&version](HdMayaLightAdapter* a) {
+            if (!a->NeedsShadowCasters()) { return; }
+            boost::hash_combine(version, a->GetID());
+            boost::hash_combine(version, a->GetShadowVersion());
+        },
+        _lightAdapters);
+    return true;
+}
+
+// Storm evaluates every simple light for every fragment, so in scenes with
+// many lights only the ones most important for the visible region are kept
+// in the render index.
+void HdMayaSceneDelegate::_SelectLights(
+    const MHWRender::MDrawContext& context) {
+    if (!GetLightsEnabled()) { return; }
+    const auto& params = GetParams();
+    if (params.maximumLights <= 0) {
+        if (!_lightSelectionEnabled) { return; }
+        _lightSelectionEnabled = false;
+        _lightsFading = false;
+        _MapAdapter<HdMayaLightAdapter>(
+            [](HdMayaLightAdapter* a) { a->UpdateSelectionFade(true, 1.0f); },
+            _lightAdapters);
+        return;
+    }
+    MStatus status;
+    const auto viewProjection =
+        context.getMatrix(MHWRender::MFrameContext::kViewProjMtx, &status);
+    if (!status) { return; }
+    _lightSelectionEnabled = true;
+    const HdMayaViewRegion region(GetGfMatrixFromMaya(viewProjection));
+    // Ranking importance, importance and the light.
+    std::vector<std::tuple<float, float, HdMayaLightAdapter*>> lights;
+    _MapAdapter<HdMayaLightAdapter>(
+        [&](HdMayaLightAdapter* a) {
+            if (a->LightType() != HdPrimTypeTokens->simpleLight ||
+                !a->IsVisible(false)) {
+                return;
+            }
+            const auto importance = a->GetImportance(region);
+            lights.emplace_back(
+                a->IsCulled() ? importance : importance * _pickedLightBias,
+                importance, a);
+        },
+        _lightAdapters);
+    std::sort(
+        lights.begin(), lights.end(),
+        [](const std::tuple<float, float, HdMayaLightAdapter*>& a,
+           const std::tuple<float, float, HdMayaLightAdapter*>& b) -> bool {
+            return std::get<0>(a) > std::get<0>(b);
+        });
+    _lightsFading = false;
+    const auto maximumLights = static_cast<size_t>(params.maximumLights);
+    for (size_t i = 0; i < lights.size(); ++i) {
+        const auto selected =
+            i < maximumLights &&
+            std::get<1>(lights[i]) > params.lightImportanceThreshold;
+        if (std::get<2>(lights[i])->UpdateSelectionFade(
+                selected, _lightFadeStep)) {
+            _lightsFading = true;
+        }
+    }
+}
+
+// Shadow casters are limited to the shapes that are lit by the light, so
+// Storm doesn't render the whole scene into each shadow map. Moving a light
+// tests every shape against it, changing a shape only tests that shape.
+void HdMayaSceneDelegate::_UpdateShadowCasters() {
+    std::vector<HdMayaLightAdapter*> lights;
+    auto rebuildLights = false;
+    _MapAdapter<HdMayaLightAdapter>(
+        [&](HdMayaLightAdapter* a) {
+            if (!a->NeedsShadowCasters()) { return; }
+            lights.push_back(a);
+            rebuildLights = rebuildLights || a->ShadowCastersDirty();
+        },
+        _lightAdapters);
+    if (lights.empty()) {
+        _shadowCastersChanged.clear();
+        return;
+    }
+    // Instanced shapes are always casters, their extent doesn't include the
+    // instance transforms.
+    const auto getCasterBounds = [](HdMayaShapeAdapter* a,
+                                    GfRange3d& bounds) -> bool {
+        if (!a->IsVisible() || !a->GetCastsShadows()) { return false; }
+        bounds = a->IsInstanced() ? GfRange3d() : a->GetWorldBounds();
+        return true;
+    };
+    if (rebuildLights) {
+        std::vector<std::pair<SdfPath, GfRange3d>> casters;
+        casters.reserve(_shapeAdapters.size());
+        GfRange3d bounds;
+        _MapAdapter<HdMayaShapeAdapter>(
+            [&](HdMayaShapeAdapter* a) {
+                if (getCasterBounds(a, bounds)) {
+                    casters.emplace_back(a->GetID(), bounds);
+                }
+            },
+            _shapeAdapters);
+        for (auto* light : lights) {
+            if (!light->ShadowCastersDirty()) { continue; }
+            SdfPathVector ids;
+            for (const auto& caster : casters) {
+                if (light->Influences(caster.second)) {
+                    ids.push_back(caster.first);
+                }
+            }
+            light->SetShadowCasters(ids);
+        }
+    }
+    for (const auto& id : _shadowCastersChanged) {
+        GfRange3d bounds;
+        auto isCaster = false;
+        if (auto* a = TfMapLookupPtr(_shapeAdapters, id)) {
+            isCaster = getCasterBounds(a->get(), bounds);
+        }
+        for (auto* light : lights) {
+            light->SetShadowCaster(id, isCaster && light->Influences(bounds));
+        }
+    }
+    _shadowCastersChanged.clear();
+}
+
 void HdMayaSceneDelegate::RemoveAdapter(const SdfPath& id) {
     if (!_RemoveAdapter<HdMayaAdapter>(
             id,
@@ -341,6 +650,9 @@ void HdMayaSceneDelegate::RemoveAdapter(const SdfPath& id) {
             "HdMayaSceneDelegate::RemoveAdapter(%s) -- Adapter does not exists",
             id.GetText());
     }
+    // Removed shapes are dropped from the shadow casters.
+    ShadowCasterChanged(id);
+    _ClearSelectedItems();
 }
 
 void HdMayaSceneDelegate::RecreateAdapterOnIdle(
@@ -365,6 +677,23 @@ void HdMayaSceneDelegate::MaterialTagChanged(const SdfPath& id) {
     }
 }
 
+void HdMayaSceneDelegate::ShadowCasterChanged(const SdfPath& id) {
+    _shadowCastersChanged.insert(id);
+}
+
+std::vector<std::pair<SdfPath, size_t>>
+HdMayaSceneDelegate::GetShadowCasterCounts() {
+    std::vector<std::pair<SdfPath, size_t>> counts;
+    _MapAdapter<HdMayaLightAdapter>(
+        [&counts](HdMayaLightAdapter* a) {
+            if (a->NeedsShadowCasters()) {
+                counts.emplace_back(a->GetID(), a->GetShadowCasterCount());
+            }
+        },
+        _lightAdapters);
+    return counts;
+}
+
 void HdMayaSceneDelegate::RebuildAdapterOnIdle(
     const SdfPath& id, uint32_t flags) {
     // We expect this to be a small number of objects, so using a simple linear
@@ -387,6 +716,8 @@ void HdMayaSceneDelegate::RecreateAdapter(
                 a->RemovePrim();
             },
             _shapeAdapters, _lightAdapters)) {
+        ShadowCasterChanged(id);
+        _ClearSelectedItems();
         MFnDagNode dgNode(obj);
         MDagPath path;
         dgNode.getPath(path);
@@ -467,29 +798,31 @@ void HdMayaSceneDelegate::InsertDag(const MDagPath& dag) {
             GetLightsEnabled());
     // We don't care about transforms.
     if (dag.hasFn(MFn::kTransform)) { return; }
+    // The new shape might be below a selected item.
+    _ClearSelectedItems();
 
     MFnDagNode dagNode(dag);
     if (dagNode.isIntermediateObject()) { return; }
 
-    // Custom lights don't have MFn::kLight.
-    if (GetLightsEnabled()) {
-        auto adapterCreator =
-            HdMayaAdapterRegistry::GetLightAdapterCreator(dag);
-        if (adapterCreator != nullptr) {
-            TF_DEBUG(HDMAYA_DELEGATE_INSERTDAG)
-                .Msg(
-                    "HdMayaSceneDelegate::InsertDag::"
-                    "found light: %s\n",
-                    dag.fullPathName().asChar());
-            const auto id = GetPrimPath(dag, true);
-            if (TfMapLookupPtr(_lightAdapters, id) != nullptr) { return; }
-            auto adapter = adapterCreator(this, dag);
-            if (adapter == nullptr || !adapter->IsSupported()) { return; }
-            adapter->Populate();
-            adapter->CreateCallbacks();
-            _lightAdapters.insert({id, adapter});
-            return;
-        }
+    // Custom lights don't have MFn::kLight. Light adapters are created even
+    // when the lights are disabled, so they can be enabled without
+    // traversing the scene again.
+    auto lightAdapterCreator =
+        HdMayaAdapterRegistry::GetLightAdapterCreator(dag);
+    if (lightAdapterCreator != nullptr) {
+        TF_DEBUG(HDMAYA_DELEGATE_INSERTDAG)
+            .Msg(
+                "HdMayaSceneDelegate::InsertDag::"
+                "found light: %s\n",
+                dag.fullPathName().asChar());
+        const auto id = GetPrimPath(dag, true);
+        if (TfMapLookupPtr(_lightAdapters, id) != nullptr) { return; }
+        auto adapter = lightAdapterCreator(this, dag);
+        if (adapter == nullptr || !adapter->IsSupported()) { return; }
+        adapter->Populate();
+        adapter->CreateCallbacks();
+        _lightAdapters.insert({id, adapter});
+        return;
     }
     TF_DEBUG(HDMAYA_DELEGATE_INSERTDAG)
         .Msg(
@@ -516,6 +849,7 @@ void HdMayaSceneDelegate::InsertDag(const MDagPath& dag) {
     adapter->Populate();
     adapter->CreateCallbacks();
     _shapeAdapters.insert({id, adapter});
+    ShadowCasterChanged(id);
 }
 
 void HdMayaSceneDelegate::NodeAdded(const MObject& obj) {
@@ -536,6 +870,15 @@ void HdMayaSceneDelegate::UpdateLightVisibility(const MDagPath& dag) {
         _lightAdapters);
 }
 
+void HdMayaSceneDelegate::RefreshFileTextures() {
+    ClearFileTextureCaches();
+    // Missing files might exist now.
+    GetTextureLoader().ClearFailedLoads();
+    _MapAdapter<HdMayaMaterialAdapter>(
+        [](HdMayaMaterialAdapter* a) { a->MarkDirty(HdMaterial::AllDirty); },
+        _materialAdapters);
+}
+
 void HdMayaSceneDelegate::AddNewInstance(const MDagPath& dag) {
     MDagPathArray dags;
     MDagPath::getAllPathsTo(dag.node(), dags);
@@ -548,6 +891,7 @@ void HdMayaSceneDelegate::AddNewInstance(const MDagPath& dag) {
         masterAdapter == nullptr) {
         return;
     }
+    _ClearSelectedItems();
     // If dags is 1, we have to recreate the adapter.
     if (dags.length() == 1 || !masterAdapter->IsInstanced()) {
         RecreateAdapterOnIdle(id, masterDag.node());
@@ -562,6 +906,21 @@ void HdMayaSceneDelegate::AddNewInstance(const MDagPath& dag) {
     }
 }
 
+void HdMayaSceneDelegate::SetLightsEnabled(const bool enabled) {
+    if (enabled == GetLightsEnabled()) { return; }
+    HdMayaDelegateCtx::SetLightsEnabled(enabled);
+    _MapAdapter<HdMayaLightAdapter>(
+        [enabled](HdMayaLightAdapter* a) {
+            if (enabled) {
+                a->Populate();
+                a->InvalidateTransform();
+            } else {
+                a->RemovePrim();
+            }
+        },
+        _lightAdapters);
+}
+
 void HdMayaSceneDelegate::SetParams(const HdMayaParams& params) {
     const auto& oldParams = GetParams();
     if (oldParams.displaySmoothMeshes != params.displaySmoothMeshes) {
@@ -605,7 +964,105 @@ void HdMayaSceneDelegate::SetParams(const HdMayaParams& params) {
             [](HdMayaLightAdapter* a) { a->MarkDirty(HdLight::AllDirty); },
             _lightAdapters);
     }
+    GetTextureBudget().SetBudget(params.textureMemoryBudget);
+    const auto playbackProfileChanged =
+        oldParams.playbackProfile != params.playbackProfile ||
+        (params.playbackProfile &&
+         oldParams.playbackRefineLevel != params.playbackRefineLevel);
+    // Refine levels with the old parameters, to dirty only the meshes the
+    // playback profile changes.
+    std::vector<std::pair<HdMayaShapeAdapter*, int>> refineLevels;
+    if (playbackProfileChanged) {
+        _MapAdapter<HdMayaShapeAdapter>(
+            [&refineLevels](HdMayaShapeAdapter* a) {
+                if (a->HasType(HdPrimTypeTokens->mesh)) {
+                    refineLevels.emplace_back(
+                        a, a->GetDisplayStyle().refineLevel);
+                }
+            },
+            _shapeAdapters);
+    }
     HdMayaDelegate::SetParams(params);
+    if (!playbackProfileChanged) { return; }
+    GetTextureLoader().SetSuspended(params.playbackProfile);
+    for (const auto& it : refineLevels) {
+        if (it.first->GetDisplayStyle().refineLevel != it.second) {
+            it.first->MarkDirty(
+                HdChangeTracker::DirtyDisplayStyle |
+                HdChangeTracker::DirtyTopology |
+                HdChangeTracker::DirtySubdivTags);
+        }
+    }
+    _MapAdapter<HdMayaShapeAdapter>(
+        [](HdMayaShapeAdapter* a) {
+            if (!a->UpdateVisibility()) { return; }
+            // Transforms are not updated while shapes are hidden.
+            a->MarkDirty(
+                HdChangeTracker::DirtyVisibility |
+                HdChangeTracker::DirtyTransform);
+            a->InvalidateTransform();
+        },
+        _shapeAdapters);
+}
+
+void HdMayaSceneDelegate::MaterialAssignmentChanged(const SdfPath& id) {
+    if (std::find(
+            _materialAssignmentsChanged.begin(),
+            _materialAssignmentsChanged.end(),
+            id) == _materialAssignmentsChanged.end()) {
+        _materialAssignmentsChanged.push_back(id);
+    }
+}
+
+void HdMayaSceneDelegate::_ClearSelectedItems() {
+    _selectedItems.clear();
+    _selectedMaterials.clear();
+}
+
+void HdMayaSceneDelegate::_ReleaseSelectedMaterial(const SdfPath& materialId) {
+    auto count = _selectedMaterials.find(materialId);
+    if (count != _selectedMaterials.end() && --count->second <= 0) {
+        _selectedMaterials.erase(count);
+    }
+}
+
+void HdMayaSceneDelegate::_UpdateSelectedMaterials() {
+    // Only the materials of the cached rprims change, the rprims below the
+    // selected items stay the same.
+    auto changed = false;
+    for (auto& it : _selectedItems) {
+        auto& item = it.second;
+        for (size_t i = 0; i < item.rprims.size(); ++i) {
+            const auto& id = std::get<0>(item.rprims[i]);
+            if (std::find(
+                    _materialAssignmentsChanged.begin(),
+                    _materialAssignmentsChanged.end(),
+                    id) == _materialAssignmentsChanged.end()) {
+                continue;
+            }
+            auto adapter = _shapeAdapters.find(id);
+            if (adapter == _shapeAdapters.end()) { continue; }
+            const auto materialId =
+                GetMaterialPath(adapter->second->GetMaterial());
+            if (materialId == item.materials[i]) { continue; }
+            _ReleaseSelectedMaterial(item.materials[i]);
+            item.materials[i] = materialId;
+            ++_selectedMaterials[materialId];
+            changed = true;
+        }
+    }
+    _materialAssignmentsChanged.clear();
+    if (changed) { _SetSelectedMaterials(); }
+}
+
+void HdMayaSceneDelegate::_SetSelectedMaterials() {
+    if (GetTextureBudget().IsEnabled()) {
+        std::unordered_set<SdfPath, SdfPath::Hash> selectedMaterials;
+        for (const auto& count : _selectedMaterials) {
+            selectedMaterials.insert(count.first);
+        }
+        GetTextureBudget().SetSelectedMaterials(std::move(selectedMaterials));
+    }
 }
 
 void HdMayaSceneDelegate::PopulateSelectedPaths(
@@ -616,6 +1073,35 @@ void HdMayaSceneDelegate::PopulateSelectedPaths(
             "HdMayaSceneDelegate::PopulateSelectedPaths - %s\n",
             GetMayaDelegateID().GetText());
 
+    // Only the output of newly selected items is computed, the output of the
+    // items that stay selected is reused from _selectedItems.
+    std::vector<MDagPath> selectedItems;
+    _DagPathSet selectedDags;
+    MDagPath selectedDag;
+    for (MItSelectionList itSel(mayaSelection); !itSel.isDone();
+         itSel.next()) {
+        if (itSel.itemType() != MItSelectionList::kDagSelectionItem) {
+            continue;
+        }
+        if (!itSel.getDagPath(selectedDag)) {
+            TF_WARN("Error getting dag path from selection");
+            continue;
+        }
+        selectedItems.push_back(selectedDag);
+        selectedDags.insert(selectedDag);
+    }
+    for (auto it = _selectedItems.begin(); it != _selectedItems.end();) {
+        if (selectedDags.find(it->first) == selectedDags.end()) {
+            for (const auto& materialId : it->second.materials) {
+                _ReleaseSelectedMaterial(materialId);
+            }
+            it = _selectedItems.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    const auto prioritizeTextures = GetTextureLoader().HasPendingLoads();
     // We need to track selected masters (but not non-instanced prims)
     // because they may not be unique when we iterate over selected items -
     // each dag path should only be iterated over once, but multiple dag
@@ -626,33 +1112,82 @@ void HdMayaSceneDelegate::PopulateSelectedPaths(
     // be a huge number of different types of instances, so tracking this
     // won't be too bad...
     std::unordered_set<SdfPath, SdfPath::Hash> selectedMasters;
-    MapSelectionDescendents(
-        mayaSelection,
-        [this, &selectedSdfPaths, &selectedMasters,
-         &selection](const MDagPath& dagPath) {
-            SdfPath primId;
-            if (dagPath.isInstanced()) {
-                auto masterDag = MDagPath();
-                if (!TF_VERIFY(
-                        MDagPath::getAPathTo(dagPath.node(), masterDag))) {
-                    return;
+    MStatus status;
+    MItDag itDag;
+    MDagPath shapeDag;
+    for (const auto& item : selectedItems) {
+        // Subtrees of selected parents are already iterated over.
+        bool parentSelected = false;
+        auto parentDag = item;
+        parentDag.pop();
+        for (; parentDag.length() > 0; parentDag.pop()) {
+            if (selectedDags.find(parentDag) != selectedDags.end()) {
+                parentSelected = true;
+                break;
+            }
+        }
+        if (parentSelected) { continue; }
+
+        auto cached = _selectedItems.find(item);
+        if (cached == _selectedItems.end()) {
+            cached = _selectedItems.emplace(item, _SelectedItem()).first;
+            auto& selectedItem = cached->second;
+            itDag.reset(item, MItDag::kDepthFirst, MFn::kShape);
+            for (; !itDag.isDone(); itDag.next()) {
+                status = itDag.getPath(shapeDag);
+                if (!status) {
+                    CHECK_MSTATUS(status);
+                    continue;
                 }
-                primId = GetPrimPath(masterDag, false);
-            } else {
-                primId = GetPrimPath(dagPath, false);
+                SdfPath primId;
+                if (shapeDag.isInstanced()) {
+                    auto masterDag = MDagPath();
+                    if (!TF_VERIFY(MDagPath::getAPathTo(
+                            shapeDag.node(), masterDag))) {
+                        continue;
+                    }
+                    primId = GetPrimPath(masterDag, false);
+                } else {
+                    primId = GetPrimPath(shapeDag, false);
+                }
+                auto adapter = _shapeAdapters.find(primId);
+                if (adapter == _shapeAdapters.end()) { continue; }
+                selectedItem.rprims.emplace_back(
+                    adapter->second->GetID(),
+                    adapter->second->GetSelectedInstance(shapeDag));
+                const auto materialId =
+                    GetMaterialPath(adapter->second->GetMaterial());
+                if (prioritizeTextures) {
+                    GetTextureLoader().SetPriority(
+                        materialId, HdMayaTextureLoader::PrioritySelected);
+                }
+                selectedItem.materials.push_back(materialId);
+                ++_selectedMaterials[materialId];
             }
-            auto adapter = _shapeAdapters.find(primId);
-            if (adapter == _shapeAdapters.end()) { return; }
+        }
 
-            TF_DEBUG(HDMAYA_DELEGATE_SELECTION)
-                .Msg(
-                    "HdMayaSceneDelegate::PopulateSelectedPaths - calling "
-                    "adapter PopulateSelectedPaths for: %s\n",
-                    adapter->second->GetID().GetText());
-            adapter->second->PopulateSelectedPaths(
-                dagPath, selectedSdfPaths, selectedMasters, selection);
-        },
-        MFn::kShape);
+        TF_DEBUG(HDMAYA_DELEGATE_SELECTION)
+            .Msg(
+                "HdMayaSceneDelegate::PopulateSelectedPaths - adding %zu "
+                "rprims for: %s\n",
+                cached->second.rprims.size(), item.fullPathName().asChar());
+        VtIntArray indices(1);
+        for (const auto& rprim : cached->second.rprims) {
+            const auto& id = std::get<0>(rprim);
+            indices[0] = std::get<1>(rprim);
+            if (indices[0] >= 0) {
+                selection->AddInstance(
+                    HdSelection::HighlightModeSelect, id, indices);
+                if (selectedMasters.insert(id).second) {
+                    selectedSdfPaths.push_back(id);
+                }
+            } else {
+                selection->AddRprim(HdSelection::HighlightModeSelect, id);
+                selectedSdfPaths.push_back(id);
+            }
+        }
+    }
+    _SetSelectedMaterials();
 }
 
 HdMeshTopology HdMayaSceneDelegate::GetMeshTopology(const SdfPath& id) {
@@ -692,6 +1227,8 @@ PxOsdSubdivTags HdMayaSceneDelegate::GetSubdivTags(const SdfPath& id) {
 GfRange3d HdMayaSceneDelegate::GetExtent(const SdfPath& id) {
     TF_DEBUG(HDMAYA_DELEGATE_GET_EXTENT)
         .Msg("HdMayaSceneDelegate::GetExtent(%s)\n", id.GetText());
+    const auto* staged = TfMapLookupPtr(_stagedShapes[0], id);
+    if (staged != nullptr) { return staged->extent; }
     return _GetValue<HdMayaShapeAdapter, GfRange3d>(
         id, [](HdMayaShapeAdapter* a) -> GfRange3d { return a->GetExtent(); },
         _shapeAdapters);
@@ -700,6 +1237,8 @@ GfRange3d HdMayaSceneDelegate::GetExtent(const SdfPath& id) {
 GfMatrix4d HdMayaSceneDelegate::GetTransform(const SdfPath& id) {
     TF_DEBUG(HDMAYA_DELEGATE_GET_TRANSFORM)
         .Msg("HdMayaSceneDelegate::GetTransform(%s)\n", id.GetText());
+    const auto* staged = TfMapLookupPtr(_stagedShapes[0], id);
+    if (staged != nullptr) { return staged->transform; }
     return _GetValue<HdMayaDagAdapter, GfMatrix4d>(
         id, [](HdMayaDagAdapter* a) -> GfMatrix4d { return a->GetTransform(); },
         _shapeAdapters, _lightAdapters);
@@ -712,6 +1251,12 @@ size_t HdMayaSceneDelegate::SampleTransform(
         .Msg(
             "HdMayaSceneDelegate::SampleTransform(%s, %u)\n", id.GetText(),
             static_cast<unsigned int>(maxSampleCount));
+    const auto* staged = TfMapLookupPtr(_stagedShapes[0], id);
+    if (staged != nullptr && maxSampleCount > 0) {
+        times[0] = 0.0f;
+        samples[0] = staged->transform;
+        return 1;
+    }
     return _GetValue<HdMayaDagAdapter, size_t>(
         id,
         [maxSampleCount, times, samples](HdMayaDagAdapter* a) -> size_t {
@@ -744,6 +1289,13 @@ VtValue HdMayaSceneDelegate::Get(const SdfPath& id, const TfToken& key) {
             },
             _shapeAdapters);
     } else {
+        if (key == HdTokens->points) {
+            const auto* staged = TfMapLookupPtr(_stagedShapes[0], id);
+            if (staged != nullptr &&
+                (staged->dirtyBits & HdChangeTracker::DirtyPoints)) {
+                return VtValue(staged->points);
+            }
+        }
         return _GetValue<HdMayaAdapter, VtValue>(
             id, [&key](HdMayaAdapter* a) -> VtValue { return a->Get(key); },
             _shapeAdapters, _lightAdapters, _materialAdapters);
@@ -768,6 +1320,15 @@ size_t HdMayaSceneDelegate::SamplePrimvar(
             _shapeAdapters);
         return 1;
     } else {
+        if (key == HdTokens->points) {
+            const auto* staged = TfMapLookupPtr(_stagedShapes[0], id);
+            if (staged != nullptr &&
+                (staged->dirtyBits & HdChangeTracker::DirtyPoints)) {
+                times[0] = 0.0f;
+                samples[0] = VtValue(staged->points);
+                return 1;
+            }
+        }
         return _GetValue<HdMayaShapeAdapter, size_t>(
             id,
             [&key, maxSampleCount, times,
@@ -28,6 +28,8 @@
 
 #include <hdmaya/hdmaya.h>
 
+#include <pxr/base/gf/matrix4d.h>
+#include <pxr/base/gf/range3d.h>
 #include <pxr/base/gf/vec4d.h>
 
 #include <pxr/usd/sdf/path.h>
@@ -39,6 +41,12 @@
 #include <maya/MObject.h>
 
 #include <memory>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include <tbb/task_group.h>
 
 #include <hdmaya/adapters/lightAdapter.h>
 #include <hdmaya/adapters/materialAdapter.h>
@@ -76,6 +84,21 @@ public:
     HDMAYA_API
     void PreFrame(const MHWRender::MDrawContext& context) override;
 
+    HDMAYA_API
+    bool IsConverged() override;
+
+    HDMAYA_API
+    bool GetShadowVersion(size_t& version) override;
+
+    HDMAYA_API
+    void PostFrame() override;
+
+    HDMAYA_API
+    int GetPipelineLatency() override;
+
+    HDMAYA_API
+    int GetPipelineStagedCount() override;
+
     HDMAYA_API
     void RemoveAdapter(const SdfPath& id) override;
 
@@ -98,6 +121,30 @@ public:
     HDMAYA_API
     void MaterialTagChanged(const SdfPath& id) override;
 
+    /// \brief Notifies the scene delegate when a shape is assigned another
+    /// material.
+    ///
+    /// The materials of the cached selection are updated in PreFrame.
+    ///
+    /// \param id Id of the Rprim that changed its material.
+    HDMAYA_API
+    void MaterialAssignmentChanged(const SdfPath& id) override;
+
+    /// \brief Notifies the scene delegate when a shape has to be culled
+    /// against the shadowed lights again.
+    ///
+    /// The shadow casters are updated in PreFrame, only when using HdSt.
+    ///
+    /// \param id Id of the Rprim that changed.
+    HDMAYA_API
+    void ShadowCasterChanged(const SdfPath& id) override;
+
+    /// \brief Returns the number of shadow casters of each shadowed light.
+    ///
+    /// Intended mostly for use in debugging and testing.
+    HDMAYA_API
+    std::vector<std::pair<SdfPath, size_t>> GetShadowCasterCounts();
+
     HDMAYA_API
     HdMayaShapeAdapterPtr GetShapeAdapter(const SdfPath& id);
 
@@ -119,6 +166,21 @@ public:
     HDMAYA_API
     void AddNewInstance(const MDagPath& dag);
 
+    /// \brief Resolves the texture file paths and UDIM tiles again.
+    ///
+    /// Clears the file texture caches and dirties all the materials.
+    HDMAYA_API
+    void RefreshFileTextures();
+
+    /// \brief Enables or disables the scene lights.
+    ///
+    /// Light adapters are kept while the lights are disabled, only their
+    /// sprims are removed from the render index.
+    ///
+    /// \param enabled True if the scene lights are used.
+    HDMAYA_API
+    void SetLightsEnabled(const bool enabled) override;
+
     HDMAYA_API
     void SetParams(const HdMayaParams& params) override;
 
@@ -244,6 +306,13 @@ protected:
 
 private:
     bool _CreateMaterial(const SdfPath& id, const MObject& obj);
+    void _SelectLights(const MHWRender::MDrawContext& context);
+    void _UpdateShadowCasters();
+    void _UpdatePointsPipeline();
+    void _ClearSelectedItems();
+    void _ReleaseSelectedMaterial(const SdfPath& materialId);
+    void _UpdateSelectedMaterials();
+    void _SetSelectedMaterials();
 
     template <typename T>
     using AdapterMap = std::unordered_map<SdfPath, T, SdfPath::Hash>;
@@ -258,8 +327,53 @@ private:
     std::vector<std::tuple<SdfPath, uint32_t>> _adaptersToRebuild;
     std::vector<MObject> _addedNodes;
     std::vector<SdfPath> _materialTagsChanged;
+    std::vector<SdfPath> _materialAssignmentsChanged;
+    std::unordered_set<SdfPath, SdfPath::Hash> _shadowCastersChanged;
+    /// \brief Selection output of a selected Maya item.
+    struct _SelectedItem {
+        /// Rprims below the item, with their selected instance, or -1 if the
+        /// whole rprim is selected.
+        std::vector<std::tuple<SdfPath, int>> rprims;
+        /// Materials of the rprims below the item, in the same order.
+        SdfPathVector materials;
+    };
+    /// \brief Hashes dag paths by their node and instance number, so no path
+    ///  names are built when the selection changes.
+    struct _DagPathHash {
+        size_t operator()(const MDagPath& dag) const;
+    };
+    using _DagPathSet = std::unordered_set<MDagPath, _DagPathHash>;
+    /// \brief Selected Maya items, by their dag path.
+    ///
+    /// Items stay in the cache while they are selected, so changing the
+    /// selection only walks the descendents of the added items. The cache is
+    /// cleared when shapes are added or removed, and the materials of the
+    /// cached rprims are updated when their assignment changes.
+    std::unordered_map<MDagPath, _SelectedItem, _DagPathHash> _selectedItems;
+    /// Number of cached rprims using each material.
+    std::unordered_map<SdfPath, int, SdfPath::Hash> _selectedMaterials;
+    /// \brief Shape data staged for pipelined playback.
+    ///
+    /// The transform and extent are staged with the points, so deforming
+    /// shapes under animated parents are drawn with the data of one frame.
+    /// The points are only staged for deforming shapes.
+    struct _StagedShape {
+        HdDirtyBits dirtyBits = 0;
+        VtVec3fArray points;
+        GfMatrix4d transform;
+        GfRange3d extent;
+    };
+    /// \brief Shapes staged for pipelined playback.
+    ///
+    /// Hydra renders the shapes extracted during the last frame, while the
+    /// shapes of the current frame are extracted to the other buffer.
+    AdapterMap<_StagedShape> _stagedShapes[2];
+    tbb::task_group _pointsExtraction;
+    bool _pipelineActive = false;
 
     SdfPath _fallbackMaterial;
+    bool _lightSelectionEnabled = false;
+    bool _lightsFading = false;
 };
 
 typedef std::shared_ptr<HdMayaSceneDelegate> MayaSceneDelegateSharedPtr;
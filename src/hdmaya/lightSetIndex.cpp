@@ -0,0 +1,149 @@
+//
+// Copyright 2019 Luma Pictures
+//
+// Licensed under the Apache License, Version 2.0 (the "Apache License")
+// with the following modification you may not use this file except in
+// compliance with the Apache License and the following modification to it:
+// Section 6. Trademarks. is deleted and replaced with:
+//
+// 6. Trademarks. This License does not grant permission to use the trade
+//    names, trademarks, service marks, or product names of the Licensor
+//    and its affiliates, except as required to comply with Section 4(c) of
+//    the License and to reproduce the content of the NOTICE file.
+//
+// You may obtain a copy of the Apache License at
+//
+//     http:#www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the Apache License with the above modification is
+// distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied. See the Apache License for the specific
+// language governing permissions and limitations under the Apache License.
+//
+#include <hdmaya/lightSetIndex.h>
+
+#include <hdmaya/hdmaya.h>
+
+#include <maya/MDagPath.h>
+#include <maya/MFnDependencyNode.h>
+#include <maya/MFnSet.h>
+#include <maya/MPlug.h>
+#include <maya/MPlugArray.h>
+#include <maya/MSelectionList.h>
+
+#include <hdmaya/adapters/mayaAttrs.h>
+
+#include <algorithm>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+namespace {
+
+const MString _defaultLightSetName("defaultLightSet");
+
+} // namespace
+
+bool HdMayaLightSetIndex::IsDefaultLightSet(const MObject& node) {
+    return _Build() && node == _defaultLightSet.object();
+}
+
+bool HdMayaLightSetIndex::IsMember(const MObject& transform) {
+    if (!_Build()) { return false; }
+    return _Find(transform) != _members.end();
+}
+
+void HdMayaLightSetIndex::MarkDirty(const MObject& transform) {
+    _dirtyTransforms.emplace_back(transform);
+}
+
+std::vector<MObject> HdMayaLightSetIndex::Update() {
+    std::vector<MObject> ret;
+    if (_dirtyTransforms.empty()) { return ret; }
+    if (!_Build()) {
+        _dirtyTransforms.clear();
+        return ret;
+    }
+    for (const auto& handle : _dirtyTransforms) {
+        if (!handle.isValid()) { continue; }
+        const auto transform = handle.object();
+        const auto it = _Find(transform);
+        const auto wasMember = it != _members.end();
+        if (_IsConnected(transform) == wasMember) { continue; }
+        if (wasMember) {
+            _members.erase(it);
+        } else {
+            _members.emplace(handle.hashCode(), handle);
+        }
+        if (std::find(ret.begin(), ret.end(), transform) == ret.end()) {
+            ret.push_back(transform);
+        }
+    }
+    _dirtyTransforms.clear();
+    return ret;
+}
+
+// The set is looked up again when the scene changes, which invalidates the
+// handle.
+bool HdMayaLightSetIndex::_Build() {
+    if (_defaultLightSet.isValid()) { return true; }
+    _members.clear();
+    _dirtyTransforms.clear();
+    MSelectionList list;
+    if (!list.add(_defaultLightSetName)) { return false; }
+    MObject set;
+    if (!list.getDependNode(0, set)) { return false; }
+    MStatus status;
+    MFnSet fnSet(set, &status);
+    if (ARCH_UNLIKELY(!status)) { return false; }
+    MSelectionList members;
+    fnSet.getMembers(members, false);
+    const auto numMembers = members.length();
+    for (auto i = decltype(numMembers){0}; i < numMembers; ++i) {
+        MDagPath dag;
+        if (!members.getDagPath(i, dag)) { continue; }
+        const auto transform = dag.transform();
+        if (_Find(transform) == _members.end()) {
+            const MObjectHandle handle(transform);
+            _members.emplace(handle.hashCode(), handle);
+        }
+    }
+    _defaultLightSet = MObjectHandle(set);
+    return true;
+}
+
+bool HdMayaLightSetIndex::_IsConnected(const MObject& transform) const {
+    MStatus status;
+    MFnDependencyNode node(transform, &status);
+    if (ARCH_UNLIKELY(!status)) { return false; }
+    auto p = node.findPlug(MayaAttrs::dagNode::instObjGroups, true);
+    if (ARCH_UNLIKELY(p.isNull())) { return false; }
+    const auto set = _defaultLightSet.object();
+    const auto numElements = p.numElements();
+    MPlugArray conns;
+    for (auto i = decltype(numElements){0}; i < numElements; ++i) {
+        auto ep = p[i]; // == elementByPhysicalIndex
+        if (!ep.connectedTo(conns, false, true) || conns.length() < 1) {
+            continue;
+        }
+        const auto numConns = conns.length();
+        for (auto j = decltype(numConns){0}; j < numConns; ++j) {
+            if (conns[j].node() == set) { return true; }
+        }
+    }
+    return false;
+}
+
+std::unordered_multimap<unsigned int, MObjectHandle>::iterator
+HdMayaLightSetIndex::_Find(const MObject& transform) {
+    const auto range =
+        _members.equal_range(MObjectHandle(transform).hashCode());
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second.isValid() && it->second.object() == transform) {
+            return it;
+        }
+    }
+    return _members.end();
+}
+
+PXR_NAMESPACE_CLOSE_SCOPE
@@ -0,0 +1,86 @@
+//
+// Copyright 2019 Luma Pictures
+//
+// Licensed under the Apache License, Version 2.0 (the "Apache License")
+// with the following modification you may not use this file except in
+// compliance with the Apache License and the following modification to it:
+// Section 6. Trademarks. is deleted and replaced with:
+//
+// 6. Trademarks. This License does not grant permission to use the trade
+//    names, trademarks, service marks, or product names of the Licensor
+//    and its affiliates, except as required to comply with Section 4(c) of
+//    the License and to reproduce the content of the NOTICE file.
+//
+// You may obtain a copy of the Apache License at
+//
+//     http:#www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the Apache License with the above modification is
+// distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied. See the Apache License for the specific
+// language governing permissions and limitations under the Apache License.
+//
+/// \file hdmaya/lightSetIndex.h
+///
+/// Membership index of the defaultLightSet.
+#ifndef __HDMAYA_LIGHT_SET_INDEX_H__
+#define __HDMAYA_LIGHT_SET_INDEX_H__
+
+#include <pxr/pxr.h>
+
+#include <hdmaya/api.h>
+
+#include <maya/MObject.h>
+#include <maya/MObjectHandle.h>
+
+#include <unordered_map>
+#include <vector>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+/// \brief Tracks which transforms are members of the defaultLightSet.
+///
+/// The index is built from the set the first time it is queried. Transforms
+/// whose instObjGroups connections to the set change are queued and checked
+/// again by Update, so light visibility does not have to walk the connections
+/// of every light and compare node names.
+class HdMayaLightSetIndex {
+public:
+    /// \brief Returns true if the node is the defaultLightSet.
+    HDMAYA_API
+    bool IsDefaultLightSet(const MObject& node);
+
+    /// \brief Returns true if the transform is a member of the
+    /// defaultLightSet.
+    HDMAYA_API
+    bool IsMember(const MObject& transform);
+
+    /// \brief Queues the membership of a transform to be checked again.
+    ///
+    /// \param transform Transform whose instObjGroups connection to the
+    ///  defaultLightSet was made or broken.
+    HDMAYA_API
+    void MarkDirty(const MObject& transform);
+
+    /// \brief Checks the membership of the queued transforms again.
+    ///
+    /// \return Transforms whose membership changed.
+    HDMAYA_API
+    std::vector<MObject> Update();
+
+private:
+    bool _Build();
+    bool _IsConnected(const MObject& transform) const;
+    std::unordered_multimap<unsigned int, MObjectHandle>::iterator _Find(
+        const MObject& transform);
+
+    // Keyed by the hash code of the transforms.
+    std::unordered_multimap<unsigned int, MObjectHandle> _members;
+    std::vector<MObjectHandle> _dirtyTransforms;
+    MObjectHandle _defaultLightSet;
+};
+
+PXR_NAMESPACE_CLOSE_SCOPE
+
+#endif // __HDMAYA_LIGHT_SET_INDEX_H__
@@ -0,0 +1,263 @@
+//
+// Copyright 2019 Luma Pictures
+//
+// Licensed under the Apache License, Version 2.0 (the "Apache License")
+// with the following modification you may not use this file except in
+// compliance with the Apache License and the following modification to it:
+// Section 6. Trademarks. is deleted and replaced with:
+//
+// 6. Trademarks. This License does not grant permission to use the trade
+//    names, trademarks, service marks, or product names of the Licensor
+//    and its affiliates, except as required to comply with Section 4(c) of
+//    the License and to reproduce the content of the NOTICE file.
+//
+// You may obtain a copy of the Apache License at
+//
+//     http:#www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the Apache License with the above modification is
+// distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied. See the Apache License for the specific
+// language governing permissions and limitations under the Apache License.
+//
+#include <hdmaya/textureBudget.h>
+
+#include <hdmaya/hdmaya.h>
+
+#include <pxr/base/tf/stl.h>
+
+#include <hdmaya/adapters/adapterDebugCodes.h>
+
+#include <algorithm>
+#include <tuple>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+namespace {
+
+// Textures are not down-levelled below this, unless they are evicted.
+constexpr size_t _minTextureMemory = 64 * 1024;
+// Dropping a mip level quarters the memory used by a texture.
+constexpr size_t _mipLevelFactor = 4;
+constexpr auto _updateInterval = std::chrono::seconds(1);
+
+} // namespace
+
+HdMayaTextureBudget::HdMayaTextureBudget()
+    : _lastUpdate(std::chrono::steady_clock::now()) {}
+
+void HdMayaTextureBudget::SetBudget(size_t budget) {
+    if (_budget == budget) { return; }
+    _budget = budget;
+    _isDirty = true;
+}
+
+size_t HdMayaTextureBudget::GetTextureMemory(
+    const TfToken& filePath, int maxTextureMemory) {
+    const auto maxMemory = static_cast<size_t>(maxTextureMemory);
+    _maxTextureMemory = maxMemory;
+    auto it = _textures.find(filePath);
+    if (it != _textures.end()) {
+        if (_budget == 0) { return maxMemory; }
+        return it->second.isEvicted
+                   ? 0
+                   : std::min(it->second.textureMemory, maxMemory);
+    }
+
+    auto& texture = _textures[filePath];
+    texture.textureMemory = maxMemory;
+    texture.lastUsed = _updateCount;
+    if (_budget != 0) {
+        // New textures start at the largest mip level fitting in the
+        // remaining budget, the next update sorts them in properly.
+        const auto remaining =
+            _budget > _estimatedUsage ? _budget - _estimatedUsage : 0;
+        while (texture.textureMemory > _minTextureMemory &&
+               texture.textureMemory > remaining) {
+            texture.textureMemory /= _mipLevelFactor;
+        }
+        _estimatedUsage += texture.textureMemory;
+        _isDirty = true;
+    }
+    return texture.textureMemory;
+}
+
+void HdMayaTextureBudget::TrackTexture(
+    const TfToken& filePath, const SdfPath& materialId,
+    const HdTextureResourceSharedPtr& resource) {
+    auto& texture = _textures[filePath];
+    if (resource) {
+        texture.resource = resource;
+        texture.hasResource = true;
+    }
+    if (std::find(
+            texture.materials.begin(), texture.materials.end(), materialId) ==
+        texture.materials.end()) {
+        texture.materials.push_back(materialId);
+        _materialTextures[materialId].push_back(filePath);
+    }
+}
+
+void HdMayaTextureBudget::MarkUsed(const SdfPath& materialId) {
+    const auto* filePaths = TfMapLookupPtr(_materialTextures, materialId);
+    if (filePaths == nullptr) { return; }
+    for (const auto& filePath : *filePaths) {
+        auto* texture = TfMapLookupPtr(_textures, filePath);
+        if (texture != nullptr) { texture->lastUsed = _updateCount; }
+    }
+}
+
+void HdMayaTextureBudget::SetSelectedMaterials(
+    std::unordered_set<SdfPath, SdfPath::Hash>&& materials) {
+    _selectedMaterials = std::move(materials);
+    if (IsEnabled()) { _isDirty = true; }
+}
+
+bool HdMayaTextureBudget::NeedsUpdate() const {
+    return _isDirty ||
+           (IsEnabled() &&
+            std::chrono::steady_clock::now() - _lastUpdate > _updateInterval);
+}
+
+SdfPathVector HdMayaTextureBudget::Update(int maxTextureMemory) {
+    const auto maxMemory = static_cast<size_t>(maxTextureMemory);
+    _maxTextureMemory = maxMemory;
+    _lastUpdate = std::chrono::steady_clock::now();
+    _isDirty = false;
+    SdfPathVector ret;
+    auto addMaterials = [&ret](const _Texture& texture) {
+        ret.insert(
+            ret.end(), texture.materials.begin(), texture.materials.end());
+    };
+
+    // Forget about textures no material holds on to anymore.
+    for (auto it = _textures.begin(); it != _textures.end();) {
+        const auto& texture = it->second;
+        if (texture.isEvicted || !texture.hasResource ||
+            !texture.resource.expired()) {
+            ++it;
+            continue;
+        }
+        for (const auto& materialId : texture.materials) {
+            auto materialIt = _materialTextures.find(materialId);
+            if (materialIt == _materialTextures.end()) { continue; }
+            auto& filePaths = materialIt->second;
+            filePaths.erase(
+                std::remove(filePaths.begin(), filePaths.end(), it->first),
+                filePaths.end());
+            if (filePaths.empty()) { _materialTextures.erase(materialIt); }
+        }
+        it = _textures.erase(it);
+    }
+
+    if (_budget == 0) {
+        for (auto& it : _textures) {
+            auto& texture = it.second;
+            if (texture.isEvicted || texture.textureMemory != maxMemory) {
+                texture.isEvicted = false;
+                texture.textureMemory = maxMemory;
+                addMaterials(texture);
+            }
+        }
+        _estimatedUsage = 0;
+        ++_updateCount;
+        return ret;
+    }
+
+    // Textures using a quarter of their target or less are not limited by
+    // it, so we know how much memory they need at full resolution.
+    std::vector<std::tuple<bool, _Texture*>> textures;
+    textures.reserve(_textures.size());
+    for (auto& it : _textures) {
+        auto& texture = it.second;
+        const auto resource = texture.resource.lock();
+        if (!texture.isEvicted && resource) {
+            const auto memoryUsed = resource->GetMemoryUsed();
+            if (memoryUsed > 0 &&
+                memoryUsed <= texture.textureMemory / _mipLevelFactor) {
+                texture.fullMemory = memoryUsed;
+            }
+        }
+        auto isSelected = false;
+        for (const auto& materialId : texture.materials) {
+            if (_selectedMaterials.find(materialId) !=
+                _selectedMaterials.end()) {
+                isSelected = true;
+                break;
+            }
+        }
+        textures.emplace_back(isSelected, &texture);
+    }
+
+    // Selected textures first, then the most recently used ones.
+    std::sort(
+        textures.begin(), textures.end(),
+        [](const std::tuple<bool, _Texture*>& a,
+           const std::tuple<bool, _Texture*>& b) {
+            if (std::get<0>(a) != std::get<0>(b)) { return std::get<0>(a); }
+            return std::get<1>(a)->lastUsed > std::get<1>(b)->lastUsed;
+        });
+
+    auto remaining = _budget;
+    _estimatedUsage = 0;
+    for (const auto& it : textures) {
+        auto& texture = *std::get<1>(it);
+        auto textureMemory = maxMemory;
+        while (textureMemory > _minTextureMemory &&
+               _GetFootprint(texture, textureMemory) > remaining) {
+            textureMemory /= _mipLevelFactor;
+        }
+        auto footprint = _GetFootprint(texture, textureMemory);
+        // Textures used by visible or selected objects are never evicted,
+        // they stay at the lowest level instead.
+        const auto isEvicted = footprint > remaining && !std::get<0>(it) &&
+                               texture.lastUsed != _updateCount;
+        if (isEvicted) { footprint = 0; }
+        remaining -= std::min(footprint, remaining);
+        _estimatedUsage += footprint;
+        if (isEvicted != texture.isEvicted ||
+            (!isEvicted && textureMemory != texture.textureMemory)) {
+            texture.isEvicted = isEvicted;
+            if (!isEvicted) { texture.textureMemory = textureMemory; }
+            addMaterials(texture);
+        }
+    }
+
+    TF_DEBUG(HDMAYA_ADAPTER_MATERIALS)
+        .Msg(
+            "HdMayaTextureBudget::Update - %zu textures, estimated usage "
+            "%zu bytes of %zu, %zu materials to update\n",
+            _textures.size(), _estimatedUsage, _budget, ret.size());
+    ++_updateCount;
+    return ret;
+}
+
+HdMayaTextureBudget::Stats HdMayaTextureBudget::GetStats() {
+    Stats ret;
+    ret.budget = _budget;
+    ret.textureCount = _textures.size();
+    for (const auto& it : _textures) {
+        const auto& texture = it.second;
+        if (texture.isEvicted) {
+            ++ret.evictedCount;
+            continue;
+        }
+        if (_GetFootprint(texture, texture.textureMemory) <
+            _GetFootprint(texture, _maxTextureMemory)) {
+            ++ret.downsampledCount;
+        }
+        const auto resource = texture.resource.lock();
+        if (resource) { ret.memoryUsed += resource->GetMemoryUsed(); }
+    }
+    return ret;
+}
+
+size_t HdMayaTextureBudget::_GetFootprint(
+    const _Texture& texture, size_t textureMemory) const {
+    return texture.fullMemory != 0 && texture.fullMemory <= textureMemory
+               ? texture.fullMemory
+               : textureMemory;
+}
+
+PXR_NAMESPACE_CLOSE_SCOPE
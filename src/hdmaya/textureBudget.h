@@ -0,0 +1,151 @@
+//
+// Copyright 2019 Luma Pictures
+//
+// Licensed under the Apache License, Version 2.0 (the "Apache License")
+// with the following modification you may not use this file except in
+// compliance with the Apache License and the following modification to it:
+// Section 6. Trademarks. is deleted and replaced with:
+//
+// 6. Trademarks. This License does not grant permission to use the trade
+//    names, trademarks, service marks, or product names of the Licensor
+//    and its affiliates, except as required to comply with Section 4(c) of
+//    the License and to reproduce the content of the NOTICE file.
+//
+// You may obtain a copy of the Apache License at
+//
+//     http:#www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the Apache License with the above modification is
+// distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied. See the Apache License for the specific
+// language governing permissions and limitations under the Apache License.
+//
+/// \file hdmaya/textureBudget.h
+///
+/// Delegate-wide texture memory budget.
+#ifndef __HDMAYA_TEXTURE_BUDGET_H__
+#define __HDMAYA_TEXTURE_BUDGET_H__
+
+#include <pxr/pxr.h>
+
+#include <hdmaya/api.h>
+
+#include <pxr/base/tf/token.h>
+
+#include <pxr/imaging/hd/textureResource.h>
+
+#include <pxr/usd/sdf/path.h>
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+/// \brief Keeps the texture memory of a delegate under a budget.
+///
+/// The budget assigns a memory target to each texture file, which is used
+/// as the memory request when creating the texture resource, so the
+/// GlfTextureRegistry discards the mip levels that don't fit. Under pressure,
+/// textures are down-levelled one mip at a time, starting with the least
+/// important and least recently used ones. Textures not used by visible
+/// objects are evicted and bound as the placeholder until they are used again.
+/// Only materials using textures whose target changed have to be synced again.
+class HdMayaTextureBudget {
+public:
+    struct Stats {
+        size_t textureCount = 0;
+        size_t memoryUsed = 0;
+        size_t budget = 0;
+        size_t downsampledCount = 0;
+        size_t evictedCount = 0;
+    };
+
+    HDMAYA_API
+    HdMayaTextureBudget();
+
+    /// \brief Sets the total texture memory budget.
+    ///
+    /// \param budget Budget in bytes, 0 disables the budget.
+    HDMAYA_API
+    void SetBudget(size_t budget);
+    bool IsEnabled() const { return _budget != 0; }
+
+    /// \brief Returns the memory target for a texture file.
+    ///
+    /// \param filePath Path to the texture file.
+    /// \param maxTextureMemory Maximum texture memory in bytes for a single
+    ///  texture.
+    /// \return Memory target in bytes, 0 if the texture is evicted.
+    HDMAYA_API
+    size_t GetTextureMemory(const TfToken& filePath, int maxTextureMemory);
+
+    /// \brief Tracks the resource created for a texture file.
+    ///
+    /// \param filePath Path to the texture file.
+    /// \param materialId Path to the material using the texture.
+    /// \param resource Texture resource created for the material.
+    HDMAYA_API
+    void TrackTexture(
+        const TfToken& filePath, const SdfPath& materialId,
+        const HdTextureResourceSharedPtr& resource);
+
+    /// \brief Marks the textures of a material used by a visible object.
+    HDMAYA_API
+    void MarkUsed(const SdfPath& materialId);
+
+    /// \brief Sets the materials of the selected objects, their textures are
+    ///  the last to be down-levelled.
+    HDMAYA_API
+    void SetSelectedMaterials(
+        std::unordered_set<SdfPath, SdfPath::Hash>&& materials);
+
+    /// \brief Returns true if the memory targets should be updated.
+    HDMAYA_API
+    bool NeedsUpdate() const;
+
+    /// \brief Updates the memory targets of the tracked textures.
+    ///
+    /// \param maxTextureMemory Maximum texture memory in bytes for a single
+    ///  texture.
+    /// \return Paths to the materials using textures whose target changed.
+    HDMAYA_API
+    SdfPathVector Update(int maxTextureMemory);
+
+    /// \brief Returns the current texture memory usage.
+    HDMAYA_API
+    Stats GetStats();
+
+private:
+    struct _Texture {
+        std::weak_ptr<HdTextureResource> resource;
+        SdfPathVector materials;
+        size_t textureMemory = 0;
+        /// Memory used by the texture at full resolution, 0 if unknown.
+        size_t fullMemory = 0;
+        size_t lastUsed = 0;
+        bool hasResource = false;
+        bool isEvicted = false;
+    };
+
+    size_t _GetFootprint(const _Texture& texture, size_t textureMemory) const;
+
+    std::unordered_map<TfToken, _Texture, TfToken::HashFunctor> _textures;
+    std::unordered_map<SdfPath, std::vector<TfToken>, SdfPath::Hash>
+        _materialTextures;
+    std::unordered_set<SdfPath, SdfPath::Hash> _selectedMaterials;
+    std::chrono::steady_clock::time_point _lastUpdate;
+    size_t _budget = 0;
+    size_t _estimatedUsage = 0;
+    size_t _maxTextureMemory = 0;
+    size_t _updateCount = 1;
+    bool _isDirty = false;
+};
+
+PXR_NAMESPACE_CLOSE_SCOPE
+
+#endif // __HDMAYA_TEXTURE_BUDGET_H__
@@ -0,0 +1,236 @@
+//
+// Copyright 2019 Luma Pictures
+//
+// Licensed under the Apache License, Version 2.0 (the "Apache License")
+// with the following modification you may not use this file except in
+// compliance with the Apache License and the following modification to it:
+// Section 6. Trademarks. is deleted and replaced with:
+//
+// 6. Trademarks. This License does not grant permission to use the trade
+//    names, trademarks, service marks, or product names of the Licensor
+//    and its affiliates, except as required to comply with Section 4(c) of
+//    the License and to reproduce the content of the NOTICE file.
+//
+// You may obtain a copy of the Apache License at
+//
+//     http:#www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the Apache License with the above modification is
+// distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied. See the Apache License for the specific
+// language governing permissions and limitations under the Apache License.
+//
+#include <hdmaya/textureCache.h>
+
+#include <pxr/base/arch/fileSystem.h>
+#include <pxr/base/tf/envSetting.h>
+#include <pxr/base/tf/fileUtils.h>
+#include <pxr/base/tf/pathUtils.h>
+#include <pxr/base/tf/stringUtils.h>
+
+#include <pxr/imaging/glf/image.h>
+
+#include <hdmaya/adapters/adapterDebugCodes.h>
+
+#include <boost/functional/hash.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <tuple>
+#include <vector>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+TF_DEFINE_ENV_SETTING(
+    HDMAYA_TEXTURE_CACHE_DIRECTORY, "",
+    "Directory to cache decoded file textures in. Disabled if empty.");
+
+TF_DEFINE_ENV_SETTING(
+    HDMAYA_TEXTURE_CACHE_SIZE, 10240,
+    "Maximum size of the texture cache directory in megabytes.");
+
+namespace {
+
+constexpr auto _cacheExtension = ".tga";
+// Temporary files still have to end with the cache extension, so the image
+// writer picks the right format.
+constexpr auto _tempExtension = ".tmp.tga";
+// Temporary files older than this are left over by crashed sessions.
+constexpr auto _tempFileLifetime = 60.0 * 60.0;
+
+// Formats that are slow to decode compared to reading uncompressed pixels.
+const std::vector<std::string> _cachedExtensions = {"png", "jpg",  "jpeg",
+                                                    "tif", "tiff", "bmp"};
+
+size_t _GetFileSize(const std::string& path) {
+    const auto size = ArchGetFileLength(path.c_str());
+    return size > 0 ? static_cast<size_t>(size) : 0;
+}
+
+bool _IsTempFile(const std::string& path) {
+    return TfStringEndsWith(path, _tempExtension);
+}
+
+} // namespace
+
+HdMayaTextureCache& HdMayaTextureCache::GetInstance() {
+    static HdMayaTextureCache instance;
+    return instance;
+}
+
+HdMayaTextureCache::HdMayaTextureCache() : _tempFileCount(0) {
+    std::random_device randomDevice;
+    _sessionId = static_cast<size_t>(randomDevice());
+    boost::hash_combine(
+        _sessionId,
+        std::chrono::high_resolution_clock::now().time_since_epoch().count());
+    const auto& directory = TfGetEnvSetting(HDMAYA_TEXTURE_CACHE_DIRECTORY);
+    if (directory.empty()) { return; }
+    if (!TfIsDir(directory) && !TfMakeDirs(directory)) {
+        TF_WARN(
+            "Unable to create texture cache directory %s", directory.c_str());
+        return;
+    }
+    _directory = TfAbsPath(directory);
+    _maxCacheSize = static_cast<size_t>(std::max(
+                        0, TfGetEnvSetting(HDMAYA_TEXTURE_CACHE_SIZE))) *
+                    1024 * 1024;
+}
+
+std::string HdMayaTextureCache::GetCachedFile(
+    const TfToken& filePath, int maxTextureMemory) {
+    if (!IsEnabled()) { return {}; }
+    auto cachedFile = _GetCachedFile(filePath, maxTextureMemory);
+    if (cachedFile.empty() || !TfIsFile(cachedFile)) { return {}; }
+    // Keeps recently used entries from being evicted.
+    TfTouchFile(cachedFile, false);
+    TF_DEBUG(HDMAYA_ADAPTER_MATERIALS)
+        .Msg(
+            "HdMayaTextureCache: reading %s from %s\n", filePath.GetText(),
+            cachedFile.c_str());
+    return cachedFile;
+}
+
+void HdMayaTextureCache::Store(
+    const TfToken& filePath, int maxTextureMemory,
+    const GlfBaseTextureDataRefPtr& data) {
+    if (!IsEnabled() || !data || data->IsCompressed() ||
+        data->GLType() != GL_UNSIGNED_BYTE || !data->HasRawBuffer(0)) {
+        return;
+    }
+    const auto cachedFile = _GetCachedFile(filePath, maxTextureMemory);
+    if (cachedFile.empty() || TfIsFile(cachedFile)) { return; }
+
+    // Written to a temporary file first, so other sessions sharing the cache
+    // never read a partial file.
+    const auto tempFile = TfStringPrintf(
+        "%s.%016zx.%zu%s", TfStringGetBeforeSuffix(cachedFile).c_str(),
+        _sessionId, _tempFileCount++, _tempExtension);
+    auto image = GlfImage::OpenForWriting(tempFile);
+    if (!image) { return; }
+    GlfImage::StorageSpec storage;
+    storage.width = data->ResizedWidth(0);
+    storage.height = data->ResizedHeight(0);
+    storage.format = data->GLFormat();
+    storage.type = data->GLType();
+    // The texture data was read with a lower left origin.
+    storage.flipped = true;
+    storage.data = data->GetRawBuffer(0);
+    if (!image->Write(storage)) {
+        TfDeleteFile(tempFile);
+        return;
+    }
+    image.reset();
+    if (std::rename(tempFile.c_str(), cachedFile.c_str()) != 0) {
+        TfDeleteFile(tempFile);
+        return;
+    }
+    TF_DEBUG(HDMAYA_ADAPTER_MATERIALS)
+        .Msg(
+            "HdMayaTextureCache: stored %s in %s\n", filePath.GetText(),
+            cachedFile.c_str());
+
+    std::lock_guard<std::mutex> lock(_cacheSizeMutex);
+    if (!_hasCacheSize) {
+        _cacheSize = 0;
+        for (const auto& file : TfListDir(_directory)) {
+            if (!_IsTempFile(file)) { _cacheSize += _GetFileSize(file); }
+        }
+        _hasCacheSize = true;
+    } else {
+        _cacheSize += _GetFileSize(cachedFile);
+    }
+    if (_cacheSize > _maxCacheSize) { _Evict(); }
+}
+
+void HdMayaTextureCache::Remove(const std::string& cachedFile) {
+    const auto size = _GetFileSize(cachedFile);
+    if (!TfDeleteFile(cachedFile)) { return; }
+    TF_DEBUG(HDMAYA_ADAPTER_MATERIALS)
+        .Msg("HdMayaTextureCache: removed unreadable %s\n", cachedFile.c_str());
+    std::lock_guard<std::mutex> lock(_cacheSizeMutex);
+    if (_hasCacheSize) { _cacheSize -= std::min(_cacheSize, size); }
+}
+
+std::string HdMayaTextureCache::_GetCachedFile(
+    const TfToken& filePath, int maxTextureMemory) {
+    const auto extension =
+        TfStringToLower(TfStringGetSuffix(filePath.GetString()));
+    if (std::find(
+            _cachedExtensions.begin(), _cachedExtensions.end(), extension) ==
+        _cachedExtensions.end()) {
+        return {};
+    }
+    double modificationTime = 0.0;
+    if (!ArchGetModificationTime(filePath.GetText(), &modificationTime)) {
+        return {};
+    }
+    size_t hash = 0;
+    boost::hash_combine(hash, filePath.GetString());
+    boost::hash_combine(hash, _GetFileSize(filePath));
+    boost::hash_combine(hash, modificationTime);
+    boost::hash_combine(hash, maxTextureMemory);
+    return TfStringCatPaths(
+        _directory, TfStringPrintf("%016zx%s", hash, _cacheExtension));
+}
+
+// Removes the least recently used entries until the cache is at 90% of its
+// maximum size, so not every store has to list the directory.
+void HdMayaTextureCache::_Evict() {
+    std::vector<std::tuple<double, size_t, std::string>> entries;
+    const auto now = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch())
+            .count());
+    for (const auto& file : TfListDir(_directory)) {
+        double modificationTime = 0.0;
+        ArchGetModificationTime(file.c_str(), &modificationTime);
+        // Temporary files might still be written by another session.
+        if (_IsTempFile(file)) {
+            if (now - modificationTime > _tempFileLifetime) {
+                TfDeleteFile(file);
+            }
+            continue;
+        }
+        entries.emplace_back(modificationTime, _GetFileSize(file), file);
+    }
+    std::sort(entries.begin(), entries.end());
+    _cacheSize = 0;
+    for (const auto& entry : entries) { _cacheSize += std::get<1>(entry); }
+    const auto targetSize = _maxCacheSize / 10 * 9;
+    for (const auto& entry : entries) {
+        if (_cacheSize <= targetSize) { break; }
+        if (TfDeleteFile(std::get<2>(entry))) {
+            _cacheSize -= std::get<1>(entry);
+        }
+    }
+    TF_DEBUG(HDMAYA_ADAPTER_MATERIALS)
+        .Msg(
+            "HdMayaTextureCache: evicted entries, cache size is %zu bytes\n",
+            _cacheSize);
+}
+
+PXR_NAMESPACE_CLOSE_SCOPE
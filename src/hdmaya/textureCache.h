@@ -0,0 +1,106 @@
+//
+// Copyright 2019 Luma Pictures
+//
+// Licensed under the Apache License, Version 2.0 (the "Apache License")
+// with the following modification you may not use this file except in
+// compliance with the Apache License and the following modification to it:
+// Section 6. Trademarks. is deleted and replaced with:
+//
+// 6. Trademarks. This License does not grant permission to use the trade
+//    names, trademarks, service marks, or product names of the Licensor
+//    and its affiliates, except as required to comply with Section 4(c) of
+//    the License and to reproduce the content of the NOTICE file.
+//
+// You may obtain a copy of the Apache License at
+//
+//     http:#www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the Apache License with the above modification is
+// distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied. See the Apache License for the specific
+// language governing permissions and limitations under the Apache License.
+//
+/// \file hdmaya/textureCache.h
+///
+/// On-disk cache of decoded file textures.
+#ifndef __HDMAYA_TEXTURE_CACHE_H__
+#define __HDMAYA_TEXTURE_CACHE_H__
+
+#include <pxr/pxr.h>
+
+#include <hdmaya/api.h>
+
+#include <pxr/base/tf/token.h>
+
+#include <pxr/imaging/glf/baseTextureData.h>
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <string>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+/// \brief Caches decoded file textures on disk.
+///
+/// The cache is enabled by pointing the HDMAYA_TEXTURE_CACHE_DIRECTORY
+/// environment variable to a directory. 8 bit textures are stored
+/// uncompressed at the resolution they were decoded at for a given memory
+/// target, so later loads skip decompressing and downsampling the source.
+/// Entries are keyed by the source path, its size and modification time and
+/// the memory target. When the cache grows over HDMAYA_TEXTURE_CACHE_SIZE
+/// megabytes, the least recently used entries are removed.
+///
+/// All functions are thread safe.
+class HdMayaTextureCache {
+public:
+    HDMAYA_API
+    static HdMayaTextureCache& GetInstance();
+
+    bool IsEnabled() const { return !_directory.empty(); }
+
+    /// \brief Returns the cached file for a texture.
+    ///
+    /// \param filePath Path to the source texture file.
+    /// \param maxTextureMemory Memory target the texture is loaded with.
+    /// \return Path to the cached file, empty if the texture is not cached.
+    HDMAYA_API
+    std::string GetCachedFile(const TfToken& filePath, int maxTextureMemory);
+
+    /// \brief Stores a decoded texture in the cache.
+    ///
+    /// \param filePath Path to the source texture file.
+    /// \param maxTextureMemory Memory target the texture was loaded with.
+    /// \param data Decoded texture data.
+    HDMAYA_API
+    void Store(
+        const TfToken& filePath, int maxTextureMemory,
+        const GlfBaseTextureDataRefPtr& data);
+
+    /// \brief Removes a cached file that failed to read.
+    ///
+    /// \param cachedFile Path to the cached file.
+    HDMAYA_API
+    void Remove(const std::string& cachedFile);
+
+private:
+    HdMayaTextureCache();
+
+    std::string _GetCachedFile(const TfToken& filePath, int maxTextureMemory);
+    void _Evict();
+
+    std::string _directory;
+    std::mutex _cacheSizeMutex;
+    size_t _cacheSize = 0;
+    size_t _maxCacheSize = 0;
+    /// Random for each session, so sessions sharing the cache never write
+    /// the same temporary file.
+    size_t _sessionId = 0;
+    std::atomic<size_t> _tempFileCount;
+    bool _hasCacheSize = false;
+};
+
+PXR_NAMESPACE_CLOSE_SCOPE
+
+#endif // __HDMAYA_TEXTURE_CACHE_H__
@@ -0,0 +1,322 @@
+//
+// Copyright 2019 Luma Pictures
+//
+// Licensed under the Apache License, Version 2.0 (the "Apache License")
+// with the following modification you may not use this file except in
+// compliance with the Apache License and the following modification to it:
+// Section 6. Trademarks. is deleted and replaced with:
+//
+// 6. Trademarks. This License does not grant permission to use the trade
+//    names, trademarks, service marks, or product names of the Licensor
+//    and its affiliates, except as required to comply with Section 4(c) of
+//    the License and to reproduce the content of the NOTICE file.
+//
+// You may obtain a copy of the Apache License at
+//
+//     http:#www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the Apache License with the above modification is
+// distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied. See the Apache License for the specific
+// language governing permissions and limitations under the Apache License.
+//
+#include <hdmaya/textureLoader.h>
+
+#include <hdmaya/hdmaya.h>
+
+#include <pxr/base/gf/vec3d.h>
+#include <pxr/base/tf/fileUtils.h>
+
+#include <pxr/imaging/glf/baseTexture.h>
+#include <pxr/imaging/glf/image.h>
+#include <pxr/imaging/glf/textureRegistry.h>
+#include <pxr/imaging/glf/uvTextureData.h>
+#include <pxr/imaging/glf/uvTextureStorage.h>
+
+#ifdef HDMAYA_USD_001901_BUILD
+#include <pxr/imaging/glf/udimTexture.h>
+#endif // HDMAYA_USD_001901_BUILD
+
+#include <pxr/imaging/hdSt/textureResource.h>
+
+#include <hdmaya/adapters/adapterDebugCodes.h>
+#include <hdmaya/textureCache.h>
+#include <hdmaya/utils.h>
+
+#include <algorithm>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+namespace {
+
+#ifdef HDMAYA_USD_001901_BUILD
+class _DecodedTexture;
+using _DecodedTextureRefPtr = TfRefPtr<_DecodedTexture>;
+
+// Texture uploading image data decoded on a worker thread. The image data
+// is released after the upload, so if the texture has to be read again,
+// ie. because the memory request changed, it is decoded on the spot.
+class _DecodedTexture : public GlfBaseTexture {
+public:
+    static _DecodedTextureRefPtr New(
+        const TfToken& filePath, const GlfBaseTextureDataRefPtr& data) {
+        return TfCreateRefPtr(new _DecodedTexture(filePath, data));
+    }
+
+protected:
+    _DecodedTexture(
+        const TfToken& filePath, const GlfBaseTextureDataRefPtr& data)
+        : GlfBaseTexture(FileTextureOrigin), _filePath(filePath), _data(data) {}
+
+    void _ReadTexture() override {
+        GlfBaseTextureDataRefPtr data = _data;
+        _data = TfNullPtr;
+        if (!data) {
+            auto uvData = GlfUVTextureData::New(
+                _filePath.GetString(), GetMemoryRequested(), 0, 0, 0, 0);
+            if (uvData) { uvData->Read(0, true, FileTextureOrigin); }
+            data = uvData;
+        }
+        _UpdateTexture(data);
+        _CreateTexture(data, true);
+        _SetLoaded();
+    }
+
+private:
+    TfToken _filePath;
+    GlfBaseTextureDataRefPtr _data;
+};
+
+class _DecodedTextureFactory : public GlfTextureFactoryBase {
+public:
+    _DecodedTextureFactory(const GlfBaseTextureDataRefPtr& data)
+        : _data(data) {}
+
+    virtual GlfTextureRefPtr New(
+        TfToken const& texturePath,
+        GlfImage::ImageOriginLocation originLocation =
+            GlfImage::OriginLowerLeft) const override {
+        return _DecodedTexture::New(texturePath, _data);
+    }
+
+    virtual GlfTextureRefPtr New(
+        TfTokenVector const& texturePaths,
+        GlfImage::ImageOriginLocation originLocation =
+            GlfImage::OriginLowerLeft) const override {
+        return nullptr;
+    }
+
+private:
+    GlfBaseTextureDataRefPtr _data;
+};
+#endif // HDMAYA_USD_001901_BUILD
+
+} // namespace
+
+HdMayaTextureLoader::HdMayaTextureLoader() : _cancelled(false) {}
+
+HdMayaTextureLoader::~HdMayaTextureLoader() {
+    _cancelled = true;
+    _tasks.cancel();
+    _tasks.wait();
+}
+
+bool HdMayaTextureLoader::RequestTexture(
+    const TfToken& filePath, int maxTextureMemory, const SdfPath& materialId) {
+#ifdef HDMAYA_USD_001901_BUILD
+    if (filePath.IsEmpty() || GlfIsSupportedUdimTexture(filePath)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(_requestsMutex);
+    if (_failedLoads.find(filePath) != _failedLoads.end()) { return false; }
+    auto it = _requests.find(filePath);
+    if (it == _requests.end()) {
+        if (GlfTextureRegistry::GetInstance().HasTexture(
+                filePath, FileTextureOrigin)) {
+            return false;
+        }
+        // Remembering missing files avoids checking the disk each time the
+        // texture resource ID is computed.
+        if (!TfPathExists(filePath)) {
+            _failedLoads.insert(filePath);
+            return false;
+        }
+        TF_DEBUG(HDMAYA_ADAPTER_MATERIALS)
+            .Msg(
+                "HdMayaTextureLoader: queueing %s for loading\n",
+                filePath.GetText());
+        it = _requests.emplace(filePath, _Request()).first;
+        it->second.order = _requestCount++;
+        it->second.maxTextureMemory = maxTextureMemory;
+        if (!_suspended) { _tasks.run([this]() { _DecodeNext(); }); }
+    }
+    auto& materials = it->second.materials;
+    if (!materialId.IsEmpty() &&
+        std::find(materials.begin(), materials.end(), materialId) ==
+            materials.end()) {
+        materials.push_back(materialId);
+    }
+    return true;
+#else
+    return false;
+#endif // HDMAYA_USD_001901_BUILD
+}
+
+HdTextureResourceSharedPtr HdMayaTextureLoader::GetTextureResource(
+    const TfToken& filePath, const std::tuple<HdWrap, HdWrap>& wrapping,
+    int maxTextureMemory, const SdfPath& materialId) {
+    if (!RequestTexture(filePath, maxTextureMemory, materialId)) {
+        return GetFileTextureResource(filePath, wrapping, maxTextureMemory);
+    }
+    return GetPlaceholder();
+}
+
+void HdMayaTextureLoader::SetPriority(const SdfPath& materialId, int priority) {
+    std::lock_guard<std::mutex> lock(_requestsMutex);
+    for (auto& it : _requests) {
+        auto& request = it.second;
+        if (request.priority >= priority) { continue; }
+        if (std::find(
+                request.materials.begin(), request.materials.end(),
+                materialId) != request.materials.end()) {
+            request.priority = priority;
+        }
+    }
+}
+
+SdfPathVector HdMayaTextureLoader::ProcessCompletedLoads() {
+    _deliveredTextures.clear();
+    SdfPathVector ret;
+#ifdef HDMAYA_USD_001901_BUILD
+    std::vector<std::tuple<TfToken, GlfBaseTextureDataRefPtr>> decoded;
+    {
+        std::lock_guard<std::mutex> lock(_requestsMutex);
+        if (_suspended) { return ret; }
+        for (auto it = _requests.begin(); it != _requests.end();) {
+            if (it->second.state != _Request::Decoded) {
+                ++it;
+                continue;
+            }
+            if (it->second.data) {
+                decoded.emplace_back(it->first, it->second.data);
+            } else {
+                TF_DEBUG(HDMAYA_ADAPTER_MATERIALS)
+                    .Msg(
+                        "HdMayaTextureLoader: failed to decode %s\n",
+                        it->first.GetText());
+                _failedLoads.insert(it->first);
+            }
+            ret.insert(
+                ret.end(), it->second.materials.begin(),
+                it->second.materials.end());
+            it = _requests.erase(it);
+        }
+    }
+    for (const auto& it : decoded) {
+        const auto& filePath = std::get<0>(it);
+        _DecodedTextureFactory factory(std::get<1>(it));
+        _deliveredTextures.push_back(
+            GlfTextureRegistry::GetInstance().GetTextureHandle(
+                filePath, FileTextureOrigin, &factory));
+    }
+#endif // HDMAYA_USD_001901_BUILD
+    return ret;
+}
+
+void HdMayaTextureLoader::ClearFailedLoads() {
+    std::lock_guard<std::mutex> lock(_requestsMutex);
+    _failedLoads.clear();
+}
+
+bool HdMayaTextureLoader::HasPendingLoads() {
+    std::lock_guard<std::mutex> lock(_requestsMutex);
+    return !_requests.empty();
+}
+
+void HdMayaTextureLoader::SetSuspended(bool suspended) {
+    std::lock_guard<std::mutex> lock(_requestsMutex);
+    if (_suspended == suspended) { return; }
+    _suspended = suspended;
+    if (suspended) { return; }
+    // Workers skipped the requests while suspended, so each queued request
+    // needs a worker again.
+    for (const auto& it : _requests) {
+        if (it.second.state == _Request::Queued) {
+            _tasks.run([this]() { _DecodeNext(); });
+        }
+    }
+}
+
+void HdMayaTextureLoader::_DecodeNext() {
+    if (_cancelled) { return; }
+    TfToken filePath;
+    int maxTextureMemory = 0;
+    {
+        // Requests are picked when a worker is free, not when they are
+        // queued, so priority changes are respected.
+        std::lock_guard<std::mutex> lock(_requestsMutex);
+        if (_suspended) { return; }
+        auto next = _requests.end();
+        for (auto it = _requests.begin(); it != _requests.end(); ++it) {
+            const auto& request = it->second;
+            if (request.state != _Request::Queued) { continue; }
+            if (next == _requests.end() ||
+                request.priority > next->second.priority ||
+                (request.priority == next->second.priority &&
+                 request.order < next->second.order)) {
+                next = it;
+            }
+        }
+        if (next == _requests.end()) { return; }
+        next->second.state = _Request::Decoding;
+        filePath = next->first;
+        maxTextureMemory = next->second.maxTextureMemory;
+    }
+
+    const auto readData = [maxTextureMemory](const std::string& path) {
+        auto data =
+            GlfUVTextureData::New(path, maxTextureMemory, 0, 0, 0, 0);
+        if (data && !data->Read(0, true, FileTextureOrigin)) {
+            data = TfNullPtr;
+        }
+        return data;
+    };
+    auto& cache = HdMayaTextureCache::GetInstance();
+    const auto cachedFile = cache.GetCachedFile(filePath, maxTextureMemory);
+    GlfUVTextureDataRefPtr data;
+    if (!cachedFile.empty()) {
+        data = readData(cachedFile);
+        // A corrupt or truncated cache entry is replaced by the source.
+        if (!data) { cache.Remove(cachedFile); }
+    }
+    if (!data) {
+        data = readData(filePath.GetString());
+        if (data) { cache.Store(filePath, maxTextureMemory, data); }
+    }
+
+    std::lock_guard<std::mutex> lock(_requestsMutex);
+    auto it = _requests.find(filePath);
+    if (it == _requests.end()) { return; }
+    it->second.data = data;
+    it->second.state = _Request::Decoded;
+}
+
+HdTextureResourceSharedPtr HdMayaTextureLoader::GetPlaceholder() {
+#ifdef HDMAYA_USD_001901_BUILD
+    if (!_placeholder) {
+        auto texture = GlfUVTextureStorage::New(
+            1, 1, VtValue(GfVec3d(0.5, 0.5, 0.5)));
+        _placeholder.reset(new HdStSimpleTextureResource(
+            GlfTextureHandle::New(texture), HdTextureType::Uv, HdWrapRepeat,
+            HdWrapRepeat,
+#ifdef HDMAYA_USD_001910_BUILD
+            HdWrapRepeat,
+#endif
+            HdMinFilterLinear, HdMagFilterLinear, 0));
+    }
+#endif // HDMAYA_USD_001901_BUILD
+    return _placeholder;
+}
+
+PXR_NAMESPACE_CLOSE_SCOPE
@@ -0,0 +1,178 @@
+//
+// Copyright 2019 Luma Pictures
+//
+// Licensed under the Apache License, Version 2.0 (the "Apache License")
+// with the following modification you may not use this file except in
+// compliance with the Apache License and the following modification to it:
+// Section 6. Trademarks. is deleted and replaced with:
+//
+// 6. Trademarks. This License does not grant permission to use the trade
+//    names, trademarks, service marks, or product names of the Licensor
+//    and its affiliates, except as required to comply with Section 4(c) of
+//    the License and to reproduce the content of the NOTICE file.
+//
+// You may obtain a copy of the Apache License at
+//
+//     http:#www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the Apache License with the above modification is
+// distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied. See the Apache License for the specific
+// language governing permissions and limitations under the Apache License.
+//
+/// \file hdmaya/textureLoader.h
+///
+/// Background loading of file textures.
+#ifndef __HDMAYA_TEXTURE_LOADER_H__
+#define __HDMAYA_TEXTURE_LOADER_H__
+
+#include <pxr/pxr.h>
+
+#include <hdmaya/api.h>
+
+#include <pxr/base/tf/token.h>
+
+#include <pxr/imaging/glf/baseTextureData.h>
+#include <pxr/imaging/glf/textureHandle.h>
+#include <pxr/imaging/hd/textureResource.h>
+#include <pxr/imaging/hd/types.h>
+
+#include <pxr/usd/sdf/path.h>
+
+#include <tbb/task_group.h>
+
+#include <atomic>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+/// \brief Decodes file textures on worker threads.
+///
+/// Textures that are not resident in the GlfTextureRegistry yet are queued
+/// for decoding and a shared 1x1 placeholder is returned in the meantime.
+/// Decoded images are handed over to the GlfTextureRegistry on the main thread
+/// by ProcessCompletedLoads, so the GL upload happens the next time Hydra
+/// binds the texture. UDIM textures and missing files are loaded
+/// synchronously, as before.
+///
+/// Except for the decoding itself, all functions must be called from the main
+/// thread.
+class HdMayaTextureLoader {
+public:
+    enum Priority : int {
+        PriorityDefault = 0,
+        PriorityVisible = 1,
+        PrioritySelected = 2,
+    };
+
+    HDMAYA_API
+    HdMayaTextureLoader();
+    HDMAYA_API
+    ~HdMayaTextureLoader();
+
+    /// \brief Queues a texture for loading, unless it is already loaded.
+    ///
+    /// Material adapters call this for each texture resource ID they compute,
+    /// so every material using the texture is synced again once it finished
+    /// loading, not only the one creating the texture resource. The ID
+    /// changes when the texture is loaded, so Hydra asks for the real
+    /// resource.
+    ///
+    /// \param filePath Path to the texture file.
+    /// \param maxTextureMemory Maximum texture memory in bytes available for
+    ///  loading the texture.
+    /// \param materialId Path to the material waiting for the texture.
+    /// \return True if requesting \p filePath returns the placeholder.
+    HDMAYA_API
+    bool RequestTexture(
+        const TfToken& filePath, int maxTextureMemory,
+        const SdfPath& materialId);
+
+    /// \brief Returns the texture resource for a texture file.
+    ///
+    /// If the texture is not loaded yet, it is queued for loading and the
+    /// placeholder resource is returned.
+    ///
+    /// \param filePath Path to the texture file.
+    /// \param wrapping Wrapping parameters for s and t axis.
+    /// \param maxTextureMemory Maximum texture memory in bytes available for
+    ///  loading the texture.
+    /// \param materialId Path to the material waiting for the texture.
+    /// \return Pointer to the Hydra Texture resource.
+    HDMAYA_API
+    HdTextureResourceSharedPtr GetTextureResource(
+        const TfToken& filePath, const std::tuple<HdWrap, HdWrap>& wrapping,
+        int maxTextureMemory, const SdfPath& materialId);
+
+    /// \brief Raises the priority of all the textures a material is waiting
+    ///  for.
+    ///
+    /// \param materialId Path to the material.
+    /// \param priority New priority of the textures, lower priorities are
+    ///  ignored.
+    HDMAYA_API
+    void SetPriority(const SdfPath& materialId, int priority);
+
+    /// \brief Hands over the decoded textures to the GlfTextureRegistry.
+    ///
+    /// \return Paths to the materials that were waiting for the textures.
+    HDMAYA_API
+    SdfPathVector ProcessCompletedLoads();
+
+    /// \brief Forgets the textures that failed to load, so they are loaded
+    ///  again the next time they are requested.
+    HDMAYA_API
+    void ClearFailedLoads();
+
+    /// \brief Returns true if there are textures queued or being decoded.
+    HDMAYA_API
+    bool HasPendingLoads();
+
+    /// \brief Stops decoding queued textures and handing over decoded ones.
+    ///
+    /// Textures are still queued while suspended, and loaded once resumed.
+    ///
+    /// \param suspended True to suspend loading, false to resume it.
+    HDMAYA_API
+    void SetSuspended(bool suspended);
+
+    /// \brief Returns the 1x1 resource bound while textures are loading.
+    HDMAYA_API
+    HdTextureResourceSharedPtr GetPlaceholder();
+
+private:
+    struct _Request {
+        enum State { Queued, Decoding, Decoded };
+
+        SdfPathVector materials;
+        GlfBaseTextureDataRefPtr data;
+        size_t order = 0;
+        int maxTextureMemory = 0;
+        int priority = PriorityDefault;
+        State state = Queued;
+    };
+
+    void _DecodeNext();
+
+    std::mutex _requestsMutex;
+    std::unordered_map<TfToken, _Request, TfToken::HashFunctor> _requests;
+    /// Textures failing to decode or missing on disk are loaded
+    /// synchronously afterwards. Guarded by _requestsMutex, like _requests.
+    std::unordered_set<TfToken, TfToken::HashFunctor> _failedLoads;
+    /// Keeps the delivered textures alive until the materials pick them up.
+    std::vector<GlfTextureHandleRefPtr> _deliveredTextures;
+    HdTextureResourceSharedPtr _placeholder;
+    tbb::task_group _tasks;
+    std::atomic<bool> _cancelled;
+    size_t _requestCount = 0;
+    bool _suspended = false;
+};
+
+PXR_NAMESPACE_CLOSE_SCOPE
+
+#endif // __HDMAYA_TEXTURE_LOADER_H__
@@ -26,7 +26,10 @@
 
 #include <hdmaya/hdmaya.h>
 
+#include <pxr/base/arch/fileSystem.h>
 #include <pxr/base/tf/fileUtils.h>
+#include <pxr/base/tf/pathUtils.h>
+#include <pxr/base/tf/weakPtr.h>
 
 #include <pxr/imaging/glf/contextCaps.h>
 #include <pxr/imaging/glf/image.h>
@@ -40,34 +43,115 @@
 
 #include <pxr/imaging/hdSt/textureResource.h>
 
+#include <maya/MObjectHandle.h>
 #include <maya/MPlugArray.h>
 
+#include <mutex>
+#include <unordered_map>
+
 PXR_NAMESPACE_OPEN_SCOPE
 
 namespace {
 
-#ifdef HDMAYA_USD_001901_BUILD
-class UdimTextureFactory : public GlfTextureFactoryBase {
-public:
-    virtual GlfTextureRefPtr New(
-        TfToken const& texturePath,
-        GlfImage::ImageOriginLocation originLocation =
-            GlfImage::OriginLowerLeft) const override {
-        const GlfContextCaps& caps = GlfContextCaps::GetInstance();
-        return GlfUdimTexture::New(
-            texturePath, originLocation,
-            UsdImaging_GetUdimTiles(texturePath, caps.maxArrayTextureLayers));
+struct _FileTexturePath {
+    MObjectHandle node;
+    MString fileTextureName;
+    short uvTilingMode = 0;
+    TfToken path;
+};
+
+// Resolved texture paths, keyed by the hash code of the file nodes. Only
+// accessed from the main thread.
+std::unordered_map<unsigned int, _FileTexturePath> _fileTexturePaths;
+
+TfToken _ResolveFileTexturePath(
+    const MFnDependencyNode& fileNode, short uvTilingMode,
+    const MString& fileTextureName) {
+    if (uvTilingMode != 0) {
+        const TfToken ret{
+            fileNode.findPlug(MayaAttrs::file::fileTextureNamePattern, true)
+                .asString()
+                .asChar()};
+        return ret.IsEmpty()
+                   ? TfToken{fileNode
+                                 .findPlug(
+                                     MayaAttrs::file::
+                                         computedFileTextureNamePattern,
+                                     true)
+                                 .asString()
+                                 .asChar()}
+                   : ret;
+    } else {
+        const TfToken ret{
+            MRenderUtil::exactFileTextureName(fileNode.object()).asChar()};
+        return ret.IsEmpty() ? TfToken{fileTextureName.asChar()} : ret;
     }
+}
 
-    virtual GlfTextureRefPtr New(
-        TfTokenVector const& texturePaths,
-        GlfImage::ImageOriginLocation originLocation =
-            GlfImage::OriginLowerLeft) const override {
-        return nullptr;
+#ifdef HDMAYA_USD_001901_BUILD
+using _UdimTiles = decltype(UsdImaging_GetUdimTiles(std::string(), 0));
+
+struct _UdimTilesEntry {
+    _UdimTiles tiles;
+    double directoryTime = 0.0;
+    int tileLimit = 0;
+};
+
+std::mutex _udimTiles_mutex;
+std::unordered_map<TfToken, _UdimTilesEntry, TfToken::HashFunctor> _udimTiles;
+
+// Tiles are only searched again when files are added to or removed from the
+// directory, which changes its modification time.
+_UdimTiles _GetUdimTiles(const TfToken& texturePath, int tileLimit) {
+    double directoryTime = 0.0;
+    ArchGetModificationTime(
+        TfGetPathName(texturePath).c_str(), &directoryTime);
+    {
+        std::lock_guard<std::mutex> lock(_udimTiles_mutex);
+        const auto it = _udimTiles.find(texturePath);
+        if (it != _udimTiles.end() && it->second.tileLimit == tileLimit &&
+            it->second.directoryTime == directoryTime) {
+            return it->second.tiles;
+        }
     }
+    auto tiles = UsdImaging_GetUdimTiles(texturePath, tileLimit);
+    std::lock_guard<std::mutex> lock(_udimTiles_mutex);
+    auto& entry = _udimTiles[texturePath];
+    entry.tiles = tiles;
+    entry.directoryTime = directoryTime;
+    entry.tileLimit = tileLimit;
+    return tiles;
+}
+
+struct _UdimTextureEntry {
+    _UdimTiles tiles;
+    GlfTextureHandlePtr handle;
 };
+
+// UDIM textures created for the current tile lists. They are not looked up by
+// their pattern in the GlfTextureRegistry, which would keep returning the
+// texture created for the old tiles while any material still binds it.
+std::unordered_map<TfToken, _UdimTextureEntry, TfToken::HashFunctor>
+    _udimTextures;
+
+GlfTextureHandleRefPtr _GetUdimTextureHandle(const TfToken& texturePath) {
+    const GlfContextCaps& caps = GlfContextCaps::GetInstance();
+    auto tiles = _GetUdimTiles(texturePath, caps.maxArrayTextureLayers);
+    std::lock_guard<std::mutex> lock(_udimTiles_mutex);
+    auto& entry = _udimTextures[texturePath];
+    if (entry.handle && entry.tiles == tiles) {
+        return TfCreateRefPtrFromProtectedWeakPtr(entry.handle);
+    }
+    auto ret = GlfTextureRegistry::GetInstance().GetTextureHandle(
+        GlfUdimTexture::New(texturePath, FileTextureOrigin, _UdimTiles(tiles)));
+    entry.tiles = std::move(tiles);
+    entry.handle = ret;
+    return ret;
+}
 #endif // HDMAYA_USD_001901_BUILD
 
+size_t _fileTextureCacheVersion = 0;
+
 } // namespace
 
 MObject GetConnectedFileNode(const MObject& obj, const TfToken& paramName) {
@@ -88,33 +172,45 @@ MObject GetConnectedFileNode(
 }
 
 TfToken GetFileTexturePath(const MFnDependencyNode& fileNode) {
-    if (fileNode.findPlug(MayaAttrs::file::uvTilingMode, true).asShort() != 0) {
-        const TfToken ret{
-            fileNode.findPlug(MayaAttrs::file::fileTextureNamePattern, true)
-                .asString()
-                .asChar()};
-        return ret.IsEmpty()
-                   ? TfToken{fileNode
-                                 .findPlug(
-                                     MayaAttrs::file::
-                                         computedFileTextureNamePattern,
-                                     true)
-                                 .asString()
-                                 .asChar()}
-                   : ret;
-    } else {
-        const TfToken ret{
-            MRenderUtil::exactFileTextureName(fileNode.object()).asChar()};
-        return ret.IsEmpty()
-                   ? TfToken{fileNode
-                                 .findPlug(
-                                     MayaAttrs::file::fileTextureName, true)
-                                 .asString()
-                                 .asChar()}
-                   : ret;
+    const auto uvTilingMode =
+        fileNode.findPlug(MayaAttrs::file::uvTilingMode, true).asShort();
+    const auto fileTextureName =
+        fileNode.findPlug(MayaAttrs::file::fileTextureName, true).asString();
+    // Image sequences resolve to a different file on each frame.
+    if (fileNode.findPlug(MayaAttrs::file::useFrameExtension, true).asBool()) {
+        return _ResolveFileTexturePath(
+            fileNode, uvTilingMode, fileTextureName);
     }
+
+    const auto node = fileNode.object();
+    const auto hashCode = MObjectHandle(node).hashCode();
+    const auto it = _fileTexturePaths.find(hashCode);
+    if (it != _fileTexturePaths.end() && it->second.node.isValid() &&
+        it->second.node == node && it->second.uvTilingMode == uvTilingMode &&
+        it->second.fileTextureName == fileTextureName) {
+        return it->second.path;
+    }
+    auto& entry = _fileTexturePaths[hashCode];
+    entry.node = MObjectHandle(node);
+    entry.fileTextureName = fileTextureName;
+    entry.uvTilingMode = uvTilingMode;
+    entry.path =
+        _ResolveFileTexturePath(fileNode, uvTilingMode, fileTextureName);
+    return entry.path;
 }
 
+void ClearFileTextureCaches() {
+    _fileTexturePaths.clear();
+    ++_fileTextureCacheVersion;
+#ifdef HDMAYA_USD_001901_BUILD
+    std::lock_guard<std::mutex> lock(_udimTiles_mutex);
+    _udimTiles.clear();
+    _udimTextures.clear();
+#endif // HDMAYA_USD_001901_BUILD
+}
+
+size_t GetFileTextureCacheVersion() { return _fileTextureCacheVersion; }
+
 std::tuple<HdWrap, HdWrap> GetFileTextureWrappingParams(
     const MObject& fileObj) {
     constexpr std::tuple<HdWrap, HdWrap> def{HdWrapClamp, HdWrapClamp};
@@ -140,6 +236,13 @@ std::tuple<HdWrap, HdWrap> GetFileTextureWrappingParams(
 
 HdTextureResourceSharedPtr GetFileTextureResource(
     const MObject& fileObj, const TfToken& filePath, int maxTextureMemory) {
+    return GetFileTextureResource(
+        filePath, GetFileTextureWrappingParams(fileObj), maxTextureMemory);
+}
+
+HdTextureResourceSharedPtr GetFileTextureResource(
+    const TfToken& filePath, const std::tuple<HdWrap, HdWrap>& wrapping,
+    int maxTextureMemory) {
     if (filePath.IsEmpty()) { return {}; }
     auto textureType = HdTextureType::Uv;
 #ifdef HDMAYA_USD_001901_BUILD
@@ -150,24 +253,18 @@ HdTextureResourceSharedPtr GetFileTextureResource(
     if (textureType != HdTextureType::Udim && !TfPathExists(filePath)) {
         return {};
     }
-    // TODO: handle origin
-    const auto origin = GlfImage::OriginLowerLeft;
     GlfTextureHandleRefPtr texture = nullptr;
     if (textureType == HdTextureType::Udim) {
 #ifdef HDMAYA_USD_001901_BUILD
-        UdimTextureFactory factory;
-        texture = GlfTextureRegistry::GetInstance().GetTextureHandle(
-            filePath, origin, &factory);
+        texture = _GetUdimTextureHandle(filePath);
 #else
         return nullptr;
 #endif
     } else {
         texture = GlfTextureRegistry::GetInstance().GetTextureHandle(
-            filePath, origin);
+            filePath, FileTextureOrigin);
     }
 
-    const auto wrapping = GetFileTextureWrappingParams(fileObj);
-
     // We can't really mimic texture wrapping and mirroring settings
     // from the uv placement node, so we don't touch those for now.
     return HdTextureResourceSharedPtr(new HdStSimpleTextureResource(
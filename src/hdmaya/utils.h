@@ -34,6 +34,7 @@
 #include <pxr/base/gf/matrix4d.h>
 #include <pxr/base/tf/token.h>
 
+#include <pxr/imaging/glf/image.h>
 #include <pxr/imaging/hd/textureResource.h>
 
 #include <maya/MDagPath.h>
@@ -84,12 +85,35 @@ MObject GetConnectedFileNode(
     const MFnDependencyNode& node, const TfToken& paramName);
 
 /// \brief Returns the texture file path from a "file" shader node.
+///
+/// Resolved paths are cached until the file texture name or the uv tiling
+/// mode of the node changes, or ClearFileTextureCaches is called.
+///
 /// \param fileNode "file" shader node.
 /// \return Full path to the texture pointed used by the file node. `<UDIM>`
 ///  tags are kept intact.
 HDMAYA_API
 TfToken GetFileTexturePath(const MFnDependencyNode& fileNode);
 
+/// \brief Clears the cached texture file paths and UDIM tile lists.
+///
+/// Needs to be called when the project root changes, since relative texture
+/// paths are resolved against it.
+HDMAYA_API
+void ClearFileTextureCaches();
+
+/// \brief Returns a number that changes each time ClearFileTextureCaches is
+///  called.
+///
+/// Texture resource IDs include it, so Hydra requests the texture resources
+/// again once the texture paths and UDIM tiles are resolved again.
+HDMAYA_API
+size_t GetFileTextureCacheVersion();
+
+/// \brief Image origin file textures are loaded with.
+// TODO: handle origin
+constexpr auto FileTextureOrigin = GlfImage::OriginLowerLeft;
+
 /// \brief Returns the texture resource from a "file" shader node.
 /// \param fileObj "file" shader object.
 /// \param filePath Path to the texture file held by "file" shader node.
@@ -103,6 +127,17 @@ HdTextureResourceSharedPtr GetFileTextureResource(
     const MObject& fileObj, const TfToken& filePath,
     int maxTextureMemory = 4 * 1024 * 1024);
 
+/// \brief Returns the texture resource for a texture file.
+/// \param filePath Path to the texture file.
+/// \param wrapping Wrapping parameters for s and t axis.
+/// \param maxTextureMemory Maximum texture memory in bytes available for
+///  loading the texture.
+/// \return Pointer to the Hydra Texture resource.
+HDMAYA_API
+HdTextureResourceSharedPtr GetFileTextureResource(
+    const TfToken& filePath, const std::tuple<HdWrap, HdWrap>& wrapping,
+    int maxTextureMemory = 4 * 1024 * 1024);
+
 /// \brief Returns the texture wrapping parameters from a "file" shader node.
 /// \param fileObj "file" shader object.
 /// \return A `std::tuple<HdWrap, HdWrap>` holding the wrapping parameters
@@ -52,40 +52,59 @@ MtohDefaultLightDelegate::MtohDefaultLightDelegate(const InitData& initData)
 
 MtohDefaultLightDelegate::~MtohDefaultLightDelegate() {
     if (ARCH_UNLIKELY(!_isSupported)) { return; }
-    if (IsHdSt()) {
-        GetRenderIndex().RemoveSprim(HdPrimTypeTokens->simpleLight, _lightPath);
-    } else {
-        GetRenderIndex().RemoveSprim(
-            HdPrimTypeTokens->distantLight, _lightPath);
-    }
+    // The override destroys the delegate while the render index is idle, so
+    // edits deferred earlier are applied first.
+    ApplyDeferredEdits();
+    TF_VERIFY(!_IsEditDeferred());
+    GetRenderIndex().RemoveSprim(_GetLightType(), _lightPath);
 }
 
 void MtohDefaultLightDelegate::Populate() {
-    _isSupported = IsHdSt() ? GetRenderIndex().IsSprimTypeSupported(
-                                  HdPrimTypeTokens->simpleLight)
-                            : GetRenderIndex().IsSprimTypeSupported(
-                                  HdPrimTypeTokens->distantLight);
+    _isSupported = GetRenderIndex().IsSprimTypeSupported(_GetLightType());
     if (ARCH_UNLIKELY(!_isSupported)) { return; }
-    if (IsHdSt()) {
-        GetRenderIndex().InsertSprim(
-            HdPrimTypeTokens->simpleLight, this, _lightPath);
+    if (_IsEditDeferred()) {
+        _DeferEdit([this]() { _InsertLight(); });
     } else {
-        GetRenderIndex().InsertSprim(
-            HdPrimTypeTokens->distantLight, this, _lightPath);
+        _InsertLight();
     }
-    GetRenderIndex().GetChangeTracker().SprimInserted(
-        _lightPath, HdLight::AllDirty);
+}
+
+bool MtohDefaultLightDelegate::GetShadowVersion(size_t& version) {
+    // Like the scene delegate, shadows are only tracked for HdSt.
+    if (!IsHdSt()) { return false; }
+    version = _shadowVersion;
+    return true;
 }
 
 void MtohDefaultLightDelegate::SetDefaultLight(const GlfSimpleLight& light) {
     if (ARCH_UNLIKELY(!_isSupported)) { return; }
     if (_light != light) {
         _light = light;
-        GetRenderIndex().GetChangeTracker().MarkSprimDirty(
-            _lightPath, HdLight::DirtyParams | HdLight::DirtyTransform);
+        ++_shadowVersion;
+        if (_IsEditDeferred()) {
+            _DeferEdit([this]() { _MarkLightDirty(); });
+        } else {
+            _MarkLightDirty();
+        }
     }
 }
 
+const TfToken& MtohDefaultLightDelegate::_GetLightType() {
+    return IsHdSt() ? HdPrimTypeTokens->simpleLight
+                    : HdPrimTypeTokens->distantLight;
+}
+
+void MtohDefaultLightDelegate::_InsertLight() {
+    GetRenderIndex().InsertSprim(_GetLightType(), this, _lightPath);
+    GetRenderIndex().GetChangeTracker().SprimInserted(
+        _lightPath, HdLight::AllDirty);
+}
+
+void MtohDefaultLightDelegate::_MarkLightDirty() {
+    GetRenderIndex().GetChangeTracker().MarkSprimDirty(
+        _lightPath, HdLight::DirtyParams | HdLight::DirtyTransform);
+}
+
 GfMatrix4d MtohDefaultLightDelegate::GetTransform(const SdfPath& id) {
     TF_UNUSED(id);
 
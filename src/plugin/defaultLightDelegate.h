@@ -47,6 +47,7 @@ public:
     ~MtohDefaultLightDelegate() override;
 
     void Populate() override;
+    bool GetShadowVersion(size_t& version) override;
     void SetDefaultLight(const GlfSimpleLight& light);
 
 protected:
@@ -57,8 +58,13 @@ protected:
     bool GetVisible(const SdfPath& id) override;
 
 private:
+    const TfToken& _GetLightType();
+    void _InsertLight();
+    void _MarkLightDirty();
+
     GlfSimpleLight _light;
     SdfPath _lightPath;
+    size_t _shadowVersion = 0;
     bool _isSupported;
 };
 
@@ -45,6 +45,11 @@ TF_REGISTRY_FUNCTION(TfDebug) {
     TF_DEBUG_ENVIRONMENT_SYMBOL(
         HDMAYA_RENDEROVERRIDE_SELECTION,
         "Print information about selection for the Maya VP2 RenderOverride.");
+
+    TF_DEBUG_ENVIRONMENT_SYMBOL(
+        HDMAYA_RENDEROVERRIDE_SHADOWS,
+        "Print information about shadow map reuse for the Maya VP2 "
+        "RenderOverride.");
 }
 
 PXR_NAMESPACE_CLOSE_SCOPE
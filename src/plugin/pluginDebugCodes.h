@@ -35,7 +35,8 @@ TF_DEBUG_CODES(
     HDMAYA_RENDEROVERRIDE_DEFAULT_LIGHTING,
     HDMAYA_RENDEROVERRIDE_RENDER,
     HDMAYA_RENDEROVERRIDE_RESOURCES,
-    HDMAYA_RENDEROVERRIDE_SELECTION
+    HDMAYA_RENDEROVERRIDE_SELECTION,
+    HDMAYA_RENDEROVERRIDE_SHADOWS
 );
 // clang-format on
 
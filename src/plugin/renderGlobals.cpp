@@ -25,6 +25,14 @@
 
 #include <hdmaya/hdmaya.h>
 
+#include <pxr/base/arch/fileSystem.h>
+#include <pxr/base/js/json.h>
+#include <pxr/base/plug/plugin.h>
+#include <pxr/base/plug/registry.h>
+#include <pxr/base/tf/envSetting.h>
+#include <pxr/base/tf/fileUtils.h>
+#include <pxr/base/tf/pathUtils.h>
+
 #include <pxr/imaging/hd/renderDelegate.h>
 #include <pxr/imaging/hdx/rendererPlugin.h>
 #include <pxr/imaging/hdx/rendererPluginRegistry.h>
@@ -42,6 +50,8 @@
 #include "tokens.h"
 #include "utils.h"
 
+#include <algorithm>
+#include <fstream>
 #include <functional>
 #include <sstream>
 
@@ -52,16 +62,38 @@ TF_DEFINE_PRIVATE_TOKENS(
     _tokens,
     (defaultRenderGlobals)
     (mtohTextureMemoryPerTexture)
+    (mtohTextureMemoryBudget)
     (mtohMaximumShadowMapResolution)
+    (mtohMaximumLights)
+    (mtohLightImportanceThreshold)
     (mtohColorSelectionHighlight)
     (mtohColorSelectionHighlightColor)
     (mtohColorSelectionHighlightColorA)
     (mtohWireframeSelectionHighlight)
     (mtohSelectionOverlay)
     (mtohEnableMotionSamples)
+    (mtohReuseUnchangedFrames)
+    (mtohDynamicResolution)
+    (mtohMinimumResolutionScale)
+    (mtohMaximumResolutionScale)
+    (mtohTargetFrameTime)
+    (mtohRenderThreadLimit)
+    (mtohRenderThread)
+    (mtohPipelinedPlayback)
+    (mtohPlaybackProfile)
+    (mtohPlaybackRefineLevel)
+    (mtohPlaybackShadows)
     );
 // clang-format on
 
+#ifdef HDMAYA_USD_001901_BUILD
+TF_DEFINE_ENV_SETTING(
+    MTOH_RENDER_SETTINGS_CACHE, "",
+    "File to cache the render settings of render delegates in, so they are "
+    "not created when the plugin is loaded. Defaults to "
+    "mtohRenderSettings.json in Maya's preferences directory.");
+#endif
+
 namespace {
 
 #ifdef HDMAYA_USD_001901_BUILD
@@ -220,12 +252,10 @@ void _GetFromPlug<int>(const MPlug& plug, int& out) {
     out = plug.asInt();
 }
 
-#ifdef HDMAYA_USD_001901_BUILD
 template <>
 void _GetFromPlug<float>(const MPlug& plug, float& out) {
     out = plug.asFloat();
 }
-#endif
 
 template <>
 void _GetFromPlug<std::string>(const MPlug& plug, std::string& out) {
@@ -259,6 +289,143 @@ bool _IsSupportedAttribute(const VtValue& v) {
     return v.IsHolding<bool>() || v.IsHolding<int>() || v.IsHolding<float>() ||
            v.IsHolding<GfVec4f>() || v.IsHolding<std::string>();
 }
+
+std::string _GetRenderSettingsCachePath() {
+    const auto& path = TfGetEnvSetting(MTOH_RENDER_SETTINGS_CACHE);
+    if (!path.empty()) { return path; }
+    MString prefDir;
+    if (!MGlobal::executeCommand("internalVar -userPrefDir", prefDir)) {
+        return {};
+    }
+    return TfStringCatPaths(prefDir.asChar(), "mtohRenderSettings.json");
+}
+
+// Identifies the build of a renderer plugin, so the settings are read from
+// its render delegate again when the plugin is updated.
+std::string _GetRendererPluginKey(const TfToken& rendererName) {
+    const auto plugin = PlugRegistry::GetInstance().GetPluginForType(
+        TfType::FindByName(rendererName.GetString()));
+    if (!plugin) { return {}; }
+    double modificationTime = 0.0;
+    ArchGetModificationTime(plugin->GetPath().c_str(), &modificationTime);
+    return TfStringPrintf(
+        "%s %s %f", rendererName.GetText(), plugin->GetPath().c_str(),
+        modificationTime);
+}
+
+JsObject _ReadRenderSettingsCache(const std::string& path) {
+    if (path.empty() || !TfIsFile(path)) { return {}; }
+    std::ifstream file(path);
+    const auto cache = JsParseStream(file);
+    return cache.IsObject() ? cache.GetJsObject() : JsObject();
+}
+
+void _WriteRenderSettingsCache(const std::string& path, const JsObject& cache) {
+    if (path.empty()) { return; }
+    std::ofstream file(path);
+    if (!file) {
+        TF_WARN("Can't write the render settings cache to %s", path.c_str());
+        return;
+    }
+    JsWriteToStream(JsValue(cache), file);
+}
+
+JsValue _SerializeRenderSettings(
+    const std::string& pluginKey,
+    const HdRenderSettingDescriptorList& descriptors) {
+    JsArray settings;
+    for (const auto& desc : descriptors) {
+        JsObject setting{{"key", JsValue(desc.key.GetString())},
+                         {"name", JsValue(desc.name)}};
+        const auto& v = desc.defaultValue;
+        if (v.IsHolding<bool>()) {
+            setting["type"] = JsValue("bool");
+            setting["value"] = JsValue(v.UncheckedGet<bool>());
+        } else if (v.IsHolding<int>()) {
+            setting["type"] = JsValue("int");
+            setting["value"] = JsValue(v.UncheckedGet<int>());
+        } else if (v.IsHolding<float>()) {
+            setting["type"] = JsValue("float");
+            setting["value"] =
+                JsValue(static_cast<double>(v.UncheckedGet<float>()));
+        } else if (v.IsHolding<GfVec4f>()) {
+            const auto& color = v.UncheckedGet<GfVec4f>();
+            setting["type"] = JsValue("color");
+            setting["value"] = JsValue(JsArray{
+                JsValue(static_cast<double>(color[0])),
+                JsValue(static_cast<double>(color[1])),
+                JsValue(static_cast<double>(color[2])),
+                JsValue(static_cast<double>(color[3]))});
+        } else if (v.IsHolding<std::string>()) {
+            setting["type"] = JsValue("string");
+            setting["value"] = JsValue(v.UncheckedGet<std::string>());
+        } else {
+            continue;
+        }
+        settings.emplace_back(std::move(setting));
+    }
+    return JsValue(JsObject{{"pluginKey", JsValue(pluginKey)},
+                            {"settings", JsValue(std::move(settings))}});
+}
+
+bool _DeserializeRenderSettings(
+    const JsValue& cached, const std::string& pluginKey,
+    HdRenderSettingDescriptorList& descriptors) {
+    if (!cached.IsObject()) { return false; }
+    const auto& entry = cached.GetJsObject();
+    const auto cachedKey = entry.find("pluginKey");
+    if (cachedKey == entry.end() || !cachedKey->second.IsString() ||
+        cachedKey->second.GetString() != pluginKey) {
+        return false;
+    }
+    const auto settings = entry.find("settings");
+    if (settings == entry.end() || !settings->second.IsArray()) {
+        return false;
+    }
+    descriptors.clear();
+    for (const auto& it : settings->second.GetJsArray()) {
+        if (!it.IsObject()) { return false; }
+        const auto& setting = it.GetJsObject();
+        const auto findValue = [&setting](const char* name) -> JsValue {
+            const auto found = setting.find(name);
+            return found == setting.end() ? JsValue() : found->second;
+        };
+        const auto key = findValue("key");
+        const auto name = findValue("name");
+        const auto type = findValue("type");
+        const auto value = findValue("value");
+        if (!key.IsString() || !name.IsString() || !type.IsString()) {
+            return false;
+        }
+        HdRenderSettingDescriptor desc;
+        desc.key = TfToken(key.GetString());
+        desc.name = name.GetString();
+        const auto& typeName = type.GetString();
+        if (typeName == "bool" && value.IsBool()) {
+            desc.defaultValue = VtValue(value.GetBool());
+        } else if (typeName == "int" && value.IsInt()) {
+            desc.defaultValue = VtValue(value.GetInt());
+        } else if (typeName == "float" && value.IsReal()) {
+            desc.defaultValue = VtValue(static_cast<float>(value.GetReal()));
+        } else if (
+            typeName == "color" && value.IsArray() &&
+            value.GetJsArray().size() == 4) {
+            GfVec4f color;
+            for (auto i = 0; i < 4; ++i) {
+                const auto& component = value.GetJsArray()[i];
+                if (!component.IsReal()) { return false; }
+                color[i] = static_cast<float>(component.GetReal());
+            }
+            desc.defaultValue = VtValue(color);
+        } else if (typeName == "string" && value.IsString()) {
+            desc.defaultValue = VtValue(value.GetString());
+        } else {
+            return false;
+        }
+        descriptors.push_back(desc);
+    }
+    return true;
+}
 #endif
 
 constexpr auto _renderOverrideOptionBoxTemplate = R"mel(
@@ -278,10 +445,17 @@ global proc {{override}}OptionBox() {
     columnLayout;
     attrControlGrp -label "Enable Motion Samples" -attribute "defaultRenderGlobals.mtohEnableMotionSamples" -changeCommand $cc;
     attrControlGrp -label "Texture Memory Per Texture (KB)" -attribute "defaultRenderGlobals.mtohTextureMemoryPerTexture" -changeCommand $cc;
+    attrControlGrp -label "Texture Memory Budget (MB, 0 is Unlimited)" -attribute "defaultRenderGlobals.mtohTextureMemoryBudget" -changeCommand $cc;
     attrControlGrp -label "OpenGL Selection Overlay" -attribute "defaultRenderGlobals.mtohSelectionOverlay" -changeCommand $cc;
     attrControlGrp -label "Show Wireframe on Selected Objects" -attribute "defaultRenderGlobals.mtohWireframeSelectionHighlight" -changeCommand $cc;
     attrControlGrp -label "Highlight Selected Objects" -attribute "defaultRenderGlobals.mtohColorSelectionHighlight" -changeCommand $cc;
     attrControlGrp -label "Highlight Color for Selected Objects" -attribute "defaultRenderGlobals.mtohColorSelectionHighlightColor" -changeCommand $cc;
+    attrControlGrp -label "Reuse Unchanged Frames" -attribute "defaultRenderGlobals.mtohReuseUnchangedFrames" -changeCommand $cc;
+    attrControlGrp -label "Render Threads (0 is All Cores)" -attribute "defaultRenderGlobals.mtohRenderThreadLimit" -changeCommand $cc;
+    attrControlGrp -label "Pipelined Playback" -attribute "defaultRenderGlobals.mtohPipelinedPlayback" -changeCommand $cc;
+    attrControlGrp -label "Playback Profile" -attribute "defaultRenderGlobals.mtohPlaybackProfile" -changeCommand $cc;
+    attrControlGrp -label "Playback Smooth Mesh Level" -attribute "defaultRenderGlobals.mtohPlaybackRefineLevel" -changeCommand $cc;
+    attrControlGrp -label "Playback Shadows" -attribute "defaultRenderGlobals.mtohPlaybackShadows" -changeCommand $cc;
     setParent ..;
     setParent ..;
     {{override}}Options();
@@ -294,8 +468,13 @@ global proc {{override}}OptionBox() {
 
 MtohRenderGlobals::MtohRenderGlobals() : selectionOverlay(MtohTokens->UseVp2) {}
 
-void MtohInitializeRenderGlobals() {
+void MtohInitializeRenderGlobals(bool refreshCache) {
     const auto& rendererDescs = MtohGetRendererDescriptions();
+#ifdef HDMAYA_USD_001901_BUILD
+    const auto cachePath = _GetRenderSettingsCachePath();
+    auto cache = _ReadRenderSettingsCache(cachePath);
+    auto cacheChanged = false;
+#endif
     for (const auto& rendererDesc : rendererDescs) {
         const auto optionBoxCommand = TfStringReplace(
             _renderOverrideOptionBoxTemplate, "{{override}}",
@@ -307,17 +486,33 @@ void MtohInitializeRenderGlobals() {
                 status.errorString().asChar());
         }
 #ifdef HDMAYA_USD_001901_BUILD
-        auto* rendererPlugin =
-            HdxRendererPluginRegistry::GetInstance().GetRendererPlugin(
-                rendererDesc.rendererName);
-        if (rendererPlugin == nullptr) { continue; }
-        auto* renderDelegate = rendererPlugin->CreateRenderDelegate();
-        if (renderDelegate == nullptr) { continue; }
-        const auto rendererSettingDescriptors =
-            renderDelegate->GetRenderSettingDescriptors();
+        // Creating a render delegate can take seconds, so it is only created
+        // when its plugin changed since the settings were cached.
+        const auto& rendererName = rendererDesc.rendererName.GetString();
+        const auto pluginKey =
+            _GetRendererPluginKey(rendererDesc.rendererName);
+        HdRenderSettingDescriptorList rendererSettingDescriptors;
+        const auto cached = cache.find(rendererName);
+        if (refreshCache || pluginKey.empty() || cached == cache.end() ||
+            !_DeserializeRenderSettings(
+                cached->second, pluginKey, rendererSettingDescriptors)) {
+            auto* rendererPlugin =
+                HdxRendererPluginRegistry::GetInstance().GetRendererPlugin(
+                    rendererDesc.rendererName);
+            if (rendererPlugin == nullptr) { continue; }
+            auto* renderDelegate = rendererPlugin->CreateRenderDelegate();
+            if (renderDelegate == nullptr) { continue; }
+            rendererSettingDescriptors =
+                renderDelegate->GetRenderSettingDescriptors();
+            delete renderDelegate;
+            if (!pluginKey.empty()) {
+                cache[rendererName] = _SerializeRenderSettings(
+                    pluginKey, rendererSettingDescriptors);
+                cacheChanged = true;
+            }
+        }
         _rendererAttributes[rendererDesc.rendererName] =
             rendererSettingDescriptors;
-        delete renderDelegate;
 
         std::stringstream ss;
         ss << "global proc " << rendererDesc.overrideName << "Options() {\n";
@@ -339,6 +534,35 @@ void MtohInitializeRenderGlobals() {
                << "\" -attribute \"defaultRenderGlobals."
                << _tokens->mtohMaximumShadowMapResolution.GetString()
                << "\" -changeCommand $cc;\n";
+            ss << "\tattrControlGrp -label \"Maximum lights (0 is all lights)"
+               << "\" -attribute \"defaultRenderGlobals."
+               << _tokens->mtohMaximumLights.GetString()
+               << "\" -changeCommand $cc;\n";
+            ss << "\tattrControlGrp -label \"Light importance threshold"
+               << "\" -attribute \"defaultRenderGlobals."
+               << _tokens->mtohLightImportanceThreshold.GetString()
+               << "\" -changeCommand $cc;\n";
+        } else {
+            ss << "\tattrControlGrp -label \"Render on a render thread"
+               << "\" -attribute \"defaultRenderGlobals."
+               << _tokens->mtohRenderThread.GetString()
+               << "\" -changeCommand $cc;\n";
+            ss << "\tattrControlGrp -label \"Dynamic resolution"
+               << "\" -attribute \"defaultRenderGlobals."
+               << _tokens->mtohDynamicResolution.GetString()
+               << "\" -changeCommand $cc;\n";
+            ss << "\tattrControlGrp -label \"Minimum resolution scale"
+               << "\" -attribute \"defaultRenderGlobals."
+               << _tokens->mtohMinimumResolutionScale.GetString()
+               << "\" -changeCommand $cc;\n";
+            ss << "\tattrControlGrp -label \"Maximum resolution scale"
+               << "\" -attribute \"defaultRenderGlobals."
+               << _tokens->mtohMaximumResolutionScale.GetString()
+               << "\" -changeCommand $cc;\n";
+            ss << "\tattrControlGrp -label \"Target frame time (ms)"
+               << "\" -attribute \"defaultRenderGlobals."
+               << _tokens->mtohTargetFrameTime.GetString()
+               << "\" -changeCommand $cc;\n";
         }
         ss << "\tsetParent ..;\n";
         ss << "\tsetParent ..;\n";
@@ -356,6 +580,9 @@ void MtohInitializeRenderGlobals() {
                 status.errorString().asChar());
         }
     }
+#ifdef HDMAYA_USD_001901_BUILD
+    if (cacheChanged) { _WriteRenderSettingsCache(cachePath, cache); }
+#endif
 }
 
 MObject MtohCreateRenderGlobals() {
@@ -386,6 +613,21 @@ MObject MtohCreateRenderGlobals() {
                 defGlobals.delegateParams.textureMemoryPerTexture / 1024);
             return o;
         });
+    _CreateNumericAttribute(
+        node, _tokens->mtohTextureMemoryBudget, MFnNumericData::kInt,
+        []() -> MObject {
+            MFnNumericAttribute nAttr;
+            const auto o = nAttr.create(
+                _tokens->mtohTextureMemoryBudget.GetText(),
+                _tokens->mtohTextureMemoryBudget.GetText(),
+                MFnNumericData::kInt);
+            nAttr.setMin(0);
+            nAttr.setSoftMax(16 * 1024);
+            nAttr.setDefault(static_cast<int>(
+                defGlobals.delegateParams.textureMemoryBudget /
+                (1024 * 1024)));
+            return o;
+        });
     _CreateNumericAttribute(
         node, _tokens->mtohMaximumShadowMapResolution, MFnNumericData::kInt,
         []() -> MObject {
@@ -400,6 +642,32 @@ MObject MtohCreateRenderGlobals() {
                 defGlobals.delegateParams.maximumShadowMapResolution);
             return o;
         });
+    _CreateNumericAttribute(
+        node, _tokens->mtohMaximumLights, MFnNumericData::kInt,
+        []() -> MObject {
+            MFnNumericAttribute nAttr;
+            const auto o = nAttr.create(
+                _tokens->mtohMaximumLights.GetText(),
+                _tokens->mtohMaximumLights.GetText(), MFnNumericData::kInt);
+            nAttr.setMin(0);
+            nAttr.setSoftMax(64);
+            nAttr.setDefault(defGlobals.delegateParams.maximumLights);
+            return o;
+        });
+    _CreateNumericAttribute(
+        node, _tokens->mtohLightImportanceThreshold, MFnNumericData::kFloat,
+        []() -> MObject {
+            MFnNumericAttribute nAttr;
+            const auto o = nAttr.create(
+                _tokens->mtohLightImportanceThreshold.GetText(),
+                _tokens->mtohLightImportanceThreshold.GetText(),
+                MFnNumericData::kFloat);
+            nAttr.setMin(0.0f);
+            nAttr.setSoftMax(1.0f);
+            nAttr.setDefault(
+                defGlobals.delegateParams.lightImportanceThreshold);
+            return o;
+        });
     static const TfTokenVector selectionOverlays{MtohTokens->UseHdSt,
                                                  MtohTokens->UseVp2};
     _CreateEnumAttribute(
@@ -415,6 +683,75 @@ MObject MtohCreateRenderGlobals() {
         node, _tokens->mtohColorSelectionHighlightColor,
         _tokens->mtohColorSelectionHighlightColorA,
         defGlobals.colorSelectionHighlightColor);
+    _CreateBoolAttribute(
+        node, _tokens->mtohReuseUnchangedFrames,
+        defGlobals.reuseUnchangedFrames);
+    _CreateNumericAttribute(
+        node, _tokens->mtohRenderThreadLimit, MFnNumericData::kInt,
+        []() -> MObject {
+            MFnNumericAttribute nAttr;
+            const auto o = nAttr.create(
+                _tokens->mtohRenderThreadLimit.GetText(),
+                _tokens->mtohRenderThreadLimit.GetText(), MFnNumericData::kInt);
+            nAttr.setMin(0);
+            nAttr.setSoftMax(64);
+            nAttr.setDefault(defGlobals.renderThreadLimit);
+            return o;
+        });
+    _CreateBoolAttribute(
+        node, _tokens->mtohRenderThread, defGlobals.renderThread);
+    _CreateBoolAttribute(
+        node, _tokens->mtohPipelinedPlayback, defGlobals.pipelinedPlayback);
+    _CreateBoolAttribute(
+        node, _tokens->mtohPlaybackProfile, defGlobals.playbackProfile);
+    _CreateNumericAttribute(
+        node, _tokens->mtohPlaybackRefineLevel, MFnNumericData::kInt,
+        []() -> MObject {
+            MFnNumericAttribute nAttr;
+            const auto o = nAttr.create(
+                _tokens->mtohPlaybackRefineLevel.GetText(),
+                _tokens->mtohPlaybackRefineLevel.GetText(),
+                MFnNumericData::kInt);
+            nAttr.setMin(0);
+            nAttr.setSoftMax(4);
+            nAttr.setDefault(defGlobals.delegateParams.playbackRefineLevel);
+            return o;
+        });
+    _CreateBoolAttribute(
+        node, _tokens->mtohPlaybackShadows, defGlobals.playbackShadows);
+    _CreateBoolAttribute(
+        node, _tokens->mtohDynamicResolution, defGlobals.dynamicResolution);
+    auto createScaleAttribute = [&node](
+                                    const TfToken& attrName, float defValue) {
+        _CreateNumericAttribute(
+            node, attrName, MFnNumericData::kFloat,
+            [&attrName, &defValue]() -> MObject {
+                MFnNumericAttribute nAttr;
+                const auto o = nAttr.create(
+                    attrName.GetText(), attrName.GetText(),
+                    MFnNumericData::kFloat);
+                nAttr.setMin(0.1f);
+                nAttr.setMax(1.0f);
+                nAttr.setDefault(defValue);
+                return o;
+            });
+    };
+    createScaleAttribute(
+        _tokens->mtohMinimumResolutionScale, defGlobals.minimumResolutionScale);
+    createScaleAttribute(
+        _tokens->mtohMaximumResolutionScale, defGlobals.maximumResolutionScale);
+    _CreateNumericAttribute(
+        node, _tokens->mtohTargetFrameTime, MFnNumericData::kFloat,
+        []() -> MObject {
+            MFnNumericAttribute nAttr;
+            const auto o = nAttr.create(
+                _tokens->mtohTargetFrameTime.GetText(),
+                _tokens->mtohTargetFrameTime.GetText(), MFnNumericData::kFloat);
+            nAttr.setMin(1.0f);
+            nAttr.setSoftMax(200.0f);
+            nAttr.setDefault(defGlobals.targetFrameTime);
+            return o;
+        });
     // TODO: Move this to an external function and add support for more types,
     //  and improve code quality/reuse.
 #ifdef HDMAYA_USD_001901_BUILD
@@ -479,12 +816,24 @@ MtohRenderGlobals MtohGetRenderGlobals() {
             ret.delegateParams.textureMemoryPerTexture)) {
         ret.delegateParams.textureMemoryPerTexture *= 1024;
     }
+    int textureMemoryBudget = 0;
+    if (_GetAttribute(
+            node, _tokens->mtohTextureMemoryBudget, textureMemoryBudget)) {
+        ret.delegateParams.textureMemoryBudget =
+            static_cast<size_t>(std::max(textureMemoryBudget, 0)) * 1024 *
+            1024;
+    }
     _GetAttribute(
         node, _tokens->mtohEnableMotionSamples,
         ret.delegateParams.enableMotionSamples);
     _GetAttribute(
         node, _tokens->mtohMaximumShadowMapResolution,
         ret.delegateParams.maximumShadowMapResolution);
+    _GetAttribute(
+        node, _tokens->mtohMaximumLights, ret.delegateParams.maximumLights);
+    _GetAttribute(
+        node, _tokens->mtohLightImportanceThreshold,
+        ret.delegateParams.lightImportanceThreshold);
     _GetEnum(node, _tokens->mtohSelectionOverlay, ret.selectionOverlay);
     _GetAttribute(
         node, _tokens->mtohWireframeSelectionHighlight,
@@ -496,6 +845,25 @@ MtohRenderGlobals MtohGetRenderGlobals() {
         node, _tokens->mtohColorSelectionHighlightColor,
         _tokens->mtohColorSelectionHighlightColorA,
         ret.colorSelectionHighlightColor);
+    _GetAttribute(
+        node, _tokens->mtohReuseUnchangedFrames, ret.reuseUnchangedFrames);
+    _GetAttribute(
+        node, _tokens->mtohRenderThreadLimit, ret.renderThreadLimit);
+    _GetAttribute(node, _tokens->mtohRenderThread, ret.renderThread);
+    _GetAttribute(
+        node, _tokens->mtohPipelinedPlayback, ret.pipelinedPlayback);
+    _GetAttribute(node, _tokens->mtohPlaybackProfile, ret.playbackProfile);
+    _GetAttribute(
+        node, _tokens->mtohPlaybackRefineLevel,
+        ret.delegateParams.playbackRefineLevel);
+    _GetAttribute(node, _tokens->mtohPlaybackShadows, ret.playbackShadows);
+    _GetAttribute(
+        node, _tokens->mtohDynamicResolution, ret.dynamicResolution);
+    _GetAttribute(
+        node, _tokens->mtohMinimumResolutionScale, ret.minimumResolutionScale);
+    _GetAttribute(
+        node, _tokens->mtohMaximumResolutionScale, ret.maximumResolutionScale);
+    _GetAttribute(node, _tokens->mtohTargetFrameTime, ret.targetFrameTime);
     // TODO: Move this to an external function and add support for more types,
     //  and improve code quality/reuse.
 #ifdef HDMAYA_USD_001901_BUILD
@@ -48,6 +48,25 @@ struct MtohRenderGlobals {
     TfToken selectionOverlay;
     bool colorSelectionHighlight = true;
     bool wireframeSelectionHighlight = true;
+    // Resolution scale limits and target frame time in milliseconds for
+    // renderers other than HdSt, while the camera or the scene is changing.
+    float minimumResolutionScale = 0.25f;
+    float maximumResolutionScale = 1.0f;
+    float targetFrameTime = 50.0f;
+    // Threads Hydra is executed with, 0 means all cores.
+    int renderThreadLimit = 0;
+    bool dynamicResolution = true;
+    // Render non-HdSt renderers on a render thread, presenting the last
+    // completed frame.
+    bool renderThread = false;
+    // Extract the scene while Hydra renders the previous frame during
+    // playback, see HdMayaParams::pipelinedPlayback.
+    bool pipelinedPlayback = false;
+    // Use the playback profile during playback, see
+    // HdMayaParams::playbackProfile, and whether it renders shadows.
+    bool playbackProfile = false;
+    bool playbackShadows = false;
+    bool reuseUnchangedFrames = false;
     struct RenderParam {
         template <typename T>
         RenderParam(const TfToken& k, const T& v) : key(k), value(v) {}
@@ -58,8 +77,10 @@ struct MtohRenderGlobals {
         rendererSettings;
 };
 
-// Reading renderer delegate attributes and generating UI code.
-void MtohInitializeRenderGlobals();
+// Reading renderer delegate attributes and generating UI code. The attributes
+// are read from a cache, unless the renderer plugin changed or refreshCache
+// is set.
+void MtohInitializeRenderGlobals(bool refreshCache = false);
 // Creating render globals attributes on "defaultRenderGlobals"
 MObject MtohCreateRenderGlobals();
 // Returning the settings stored on "defaultRenderGlobals"
@@ -27,28 +27,42 @@
 
 #include <pxr/base/gf/matrix4d.h>
 
+#include <pxr/base/tf/envSetting.h>
 #include <pxr/base/tf/instantiateSingleton.h>
+#include <pxr/base/tf/stopwatch.h>
+#include <pxr/base/tf/stringUtils.h>
 
 #include <pxr/imaging/glf/contextCaps.h>
 
 #include <pxr/imaging/hd/rprim.h>
+#include <pxr/imaging/hdx/renderTask.h>
 #include <pxr/imaging/hdx/rendererPlugin.h>
 #include <pxr/imaging/hdx/rendererPluginRegistry.h>
+#include <pxr/imaging/hdx/shadowTask.h>
 #include <pxr/imaging/hdx/tokens.h>
 
 #include <maya/M3dView.h>
+#include <maya/MAnimControl.h>
 #include <maya/MDagPath.h>
 #include <maya/MDrawContext.h>
 #include <maya/MEventMessage.h>
 #include <maya/MGlobal.h>
 #include <maya/MNodeMessage.h>
+#include <maya/MRenderTargetManager.h>
 #include <maya/MSceneMessage.h>
 #include <maya/MSelectionList.h>
 #include <maya/MTimerMessage.h>
 #include <maya/MUiMessage.h>
 
+#include <boost/functional/hash.hpp>
+
+#include <tbb/task_scheduler_init.h>
+
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <chrono>
+#include <cmath>
 #include <exception>
 
 #include <hdmaya/delegates/delegateRegistry.h>
@@ -70,6 +84,11 @@
 
 PXR_NAMESPACE_OPEN_SCOPE
 
+TF_DEFINE_ENV_SETTING(
+    MTOH_VALIDATE_GL_STATE, false,
+    "Queries the GL state handed over by VP2 every frame, and warns if it "
+    "differs from the shadow copy used to restore it.");
+
 namespace {
 
 // Not sure if we actually need a mutex guarding _allInstances, but
@@ -78,6 +97,23 @@ namespace {
 std::mutex _allInstancesMutex;
 std::vector<MtohRenderOverride*> _allInstances;
 
+// Limits of the refresh interval while the renderer is converging, in
+// seconds.
+constexpr float _minRefreshInterval = 1.0f / 60.0f;
+constexpr float _maxRefreshInterval = 0.5f;
+// Largest fraction of the main thread's time spent refreshing the viewport
+// while converging, so Maya stays interactive.
+constexpr float _refreshDutyCycle = 0.5f;
+// Viewports that were not rendered for this long are not refreshed anymore,
+// for example because their panel is hidden.
+constexpr auto _refreshTimeout = std::chrono::seconds(5);
+// Maya renders the panels of a refresh back to back, a longer pause between
+// two renders starts a new refresh.
+constexpr auto _refreshGap = std::chrono::milliseconds(100);
+// Frames rendered at a lower resolution are refined when neither the camera
+// nor the scene changed for this long.
+constexpr auto _refineDelay = std::chrono::milliseconds(250);
+
 #if HDMAYA_UFE_BUILD
 
 // Observe UFE scene items for transformation changed only when they are
@@ -111,7 +147,7 @@ private:
 
 #endif // HDMAYA_UFE_BUILD
 
-/// Simple RAII class to save uniform buffer bindings, to deal with a maya
+/// Simple RAII class to restore uniform buffer bindings, to deal with a maya
 /// issue.
 ///
 /// As originally explained by Pixar in their usdmaya plugin:
@@ -153,6 +189,37 @@ private:
     std::array<GLint, UNIFORM_BINDINGS_TO_SAVE> _uniformBufferBindings;
 };
 
+// The GL context is shared by all the VP2 panels, so is the shadow copy of
+// its state.
+HdMayaGLStateShadow _glStateShadow;
+
+// Copies of the last frame rendered to each panel.
+HdMayaFrameCache _frameCache;
+
+HdMayaFrameCache::Targets _GetFrameCacheTargets(
+    const MHWRender::MDrawContext& drawContext) {
+    HdMayaFrameCache::Targets targets;
+    drawContext.getRenderTargetSize(targets.width, targets.height);
+    const auto* targetManager =
+        MHWRender::MRenderer::theRenderer()->getRenderTargetManager();
+    if (targetManager == nullptr) { return targets; }
+    MHWRender::MRenderTargetDescription description;
+    auto* colorTarget = drawContext.getCurrentColorRenderTarget();
+    if (colorTarget != nullptr) {
+        colorTarget->targetDescription(description);
+        targets.sampleCount = static_cast<int>(description.multiSampleCount());
+        targets.colorFormat = static_cast<int>(description.rasterFormat());
+        targetManager->releaseRenderTarget(colorTarget);
+    }
+    auto* depthTarget = drawContext.getCurrentDepthRenderTarget();
+    if (depthTarget != nullptr) {
+        depthTarget->targetDescription(description);
+        targets.depthFormat = static_cast<int>(description.rasterFormat());
+        targetManager->releaseRenderTarget(depthTarget);
+    }
+    return targets;
+}
+
 } // namespace
 
 MtohRenderOverride::MtohRenderOverride(const MtohRendererDescription& desc)
@@ -185,21 +252,6 @@ MtohRenderOverride::MtohRenderOverride(const MtohRendererDescription& desc)
               .AppendChild(TfToken(TfStringPrintf(
                   "_HdMaya_%s_%p", desc.rendererName.GetText(), this)));
 
-    MStatus status;
-    auto id = MSceneMessage::addCallback(
-        MSceneMessage::kBeforeNew, _ClearHydraCallback, this, &status);
-    if (status) { _callbacks.push_back(id); }
-    id = MSceneMessage::addCallback(
-        MSceneMessage::kBeforeOpen, _ClearHydraCallback, this, &status);
-    if (status) { _callbacks.push_back(id); }
-    id = MEventMessage::addEventCallback(
-        MString("SelectionChanged"), _SelectionChangedCallback, this, &status);
-    if (status) { _callbacks.push_back(id); }
-
-    id = MTimerMessage::addTimerCallback(
-        1.0f / 10.0f, _TimerCallback, this, &status);
-    if (status) { _callbacks.push_back(id); }
-
     _defaultLight.SetSpecular(GfVec4f(0.0f));
     _defaultLight.SetAmbient(GfVec4f(0.0f));
 
@@ -209,15 +261,6 @@ MtohRenderOverride::MtohRenderOverride(const MtohRendererDescription& desc)
     }
 
     _globals = MtohGetRenderGlobals();
-
-#if HDMAYA_UFE_BUILD
-    const UFE_NS::GlobalSelection::Ptr& ufeSelection =
-        UFE_NS::GlobalSelection::get();
-    if (ufeSelection) {
-        _ufeSelectionObserver = std::make_shared<UfeSelectionObserver>(*this);
-        ufeSelection->addObserver(_ufeSelectionObserver);
-    }
-#endif // HDMAYA_UFE_BUILD
 }
 
 MtohRenderOverride::~MtohRenderOverride() {
@@ -232,7 +275,7 @@ MtohRenderOverride::~MtohRenderOverride() {
 
     for (auto operation : _operations) { delete operation; }
 
-    for (auto callback : _callbacks) { MMessage::removeCallback(callback); }
+    _DetachCallbacks();
     for (auto& panelAndCallbacks : _renderPanelCallbacks) {
         MMessage::removeCallbacks(panelAndCallbacks.second);
     }
@@ -243,15 +286,64 @@ MtohRenderOverride::~MtohRenderOverride() {
             std::remove(_allInstances.begin(), _allInstances.end(), this),
             _allInstances.end());
     }
+}
+
+void MtohRenderOverride::_AttachCallbacks() {
+    if (_hasCallbacks) { return; }
+    TF_DEBUG(HDMAYA_RENDEROVERRIDE_RESOURCES)
+        .Msg(
+            "MtohRenderOverride::_AttachCallbacks(%s)\n",
+            _rendererDesc.rendererName.GetText());
+
+    MStatus status;
+    auto id = MSceneMessage::addCallback(
+        MSceneMessage::kBeforeNew, _ClearHydraCallback, this, &status);
+    if (status) { _callbacks.push_back(id); }
+    id = MSceneMessage::addCallback(
+        MSceneMessage::kBeforeOpen, _ClearHydraCallback, this, &status);
+    if (status) { _callbacks.push_back(id); }
+    id = MEventMessage::addEventCallback(
+        MString("SelectionChanged"), _SelectionChangedCallback, this, &status);
+    if (status) { _callbacks.push_back(id); }
+
+#if HDMAYA_UFE_BUILD
+    const UFE_NS::GlobalSelection::Ptr& ufeSelection =
+        UFE_NS::GlobalSelection::get();
+    if (ufeSelection) {
+        _ufeSelectionObserver = std::make_shared<UfeSelectionObserver>(*this);
+        ufeSelection->addObserver(_ufeSelectionObserver);
+    }
+#endif // HDMAYA_UFE_BUILD
+
+    _hasCallbacks = true;
+    // The selection was not tracked while dormant.
+    SelectionChanged();
+}
+
+void MtohRenderOverride::_DetachCallbacks() {
+    if (!_hasCallbacks) { return; }
+    TF_DEBUG(HDMAYA_RENDEROVERRIDE_RESOURCES)
+        .Msg(
+            "MtohRenderOverride::_DetachCallbacks(%s)\n",
+            _rendererDesc.rendererName.GetText());
+
+    {
+        std::lock_guard<std::mutex> lock(_convergenceMutex);
+        _RemoveRefreshTimer();
+    }
+    for (auto callback : _callbacks) { MMessage::removeCallback(callback); }
+    _callbacks.clear();
 
 #if HDMAYA_UFE_BUILD
     const UFE_NS::GlobalSelection::Ptr& ufeSelection =
         UFE_NS::GlobalSelection::get();
     if (ufeSelection) {
         ufeSelection->removeObserver(_ufeSelectionObserver);
-        _ufeSelectionObserver = nullptr;
     }
+    _ufeSelectionObserver = nullptr;
 #endif // HDMAYA_UFE_BUILD
+
+    _hasCallbacks = false;
 }
 
 void MtohRenderOverride::UpdateRenderGlobals() {
@@ -261,6 +353,18 @@ void MtohRenderOverride::UpdateRenderGlobals() {
     }
 }
 
+void MtohRenderOverride::RefreshFileTextures() {
+    ClearFileTextureCaches();
+    std::lock_guard<std::mutex> lock(_allInstancesMutex);
+    for (auto* instance : _allInstances) {
+        for (auto& delegate : instance->_delegates) {
+            auto sceneDelegate =
+                std::dynamic_pointer_cast<HdMayaSceneDelegate>(delegate);
+            if (sceneDelegate) { sceneDelegate->RefreshFileTextures(); }
+        }
+    }
+}
+
 std::vector<MString> MtohRenderOverride::AllActiveRendererNames() {
     std::vector<MString> renderers;
 
@@ -295,6 +399,27 @@ SdfPathVector MtohRenderOverride::RendererRprims(
     return primIds;
 }
 
+std::vector<std::string> MtohRenderOverride::RendererSelection(
+    TfToken rendererName) {
+    MtohRenderOverride* instance = _GetByName(rendererName);
+    if (!instance) { return {}; }
+
+    std::vector<std::string> ret;
+    for (const auto& id : instance->_selectionCollection.GetRootPaths()) {
+        ret.push_back("collection: " + id.GetString());
+    }
+    const auto selection = instance->_selectionTracker->GetSelectionMap();
+    if (selection) {
+        auto highlighted =
+            selection->GetSelectedPrimPaths(HdSelection::HighlightModeSelect);
+        std::sort(highlighted.begin(), highlighted.end());
+        for (const auto& id : highlighted) {
+            ret.push_back("highlighted: " + id.GetString());
+        }
+    }
+    return ret;
+}
+
 SdfPath MtohRenderOverride::RendererSceneDelegateId(
     TfToken rendererName, TfToken sceneDelegateName) {
     MtohRenderOverride* instance = _GetByName(rendererName);
@@ -308,6 +433,125 @@ SdfPath MtohRenderOverride::RendererSceneDelegateId(
     return SdfPath();
 }
 
+std::vector<std::string> MtohRenderOverride::RendererTextureMemoryUsage(
+    TfToken rendererName) {
+    MtohRenderOverride* instance = _GetByName(rendererName);
+    if (!instance) { return {}; }
+
+    constexpr auto megabyte = 1024.0 * 1024.0;
+    std::vector<std::string> ret;
+    for (auto& delegate : instance->_delegates) {
+        auto delegateCtx =
+            std::dynamic_pointer_cast<HdMayaDelegateCtx>(delegate);
+        if (!delegateCtx) { continue; }
+        const auto stats = delegateCtx->GetTextureBudget().GetStats();
+        ret.push_back(TfStringPrintf(
+            "%s: %zu textures, %.1f MB used of %s, %zu downsampled, "
+            "%zu evicted",
+            delegate->GetName().GetText(), stats.textureCount,
+            static_cast<double>(stats.memoryUsed) / megabyte,
+            stats.budget == 0
+                ? "unlimited budget"
+                : TfStringPrintf(
+                      "%.1f MB budget",
+                      static_cast<double>(stats.budget) / megabyte)
+                      .c_str(),
+            stats.downsampledCount, stats.evictedCount));
+    }
+    return ret;
+}
+
+std::vector<std::string> MtohRenderOverride::RendererShadowCasterCounts(
+    TfToken rendererName) {
+    MtohRenderOverride* instance = _GetByName(rendererName);
+    if (!instance) { return {}; }
+
+    std::vector<std::string> ret;
+    for (auto& delegate : instance->_delegates) {
+        auto sceneDelegate =
+            std::dynamic_pointer_cast<HdMayaSceneDelegate>(delegate);
+        if (!sceneDelegate) { continue; }
+        for (const auto& count : sceneDelegate->GetShadowCasterCounts()) {
+            ret.push_back(TfStringPrintf(
+                "%s: %zu shadow casters", count.first.GetText(),
+                count.second));
+        }
+    }
+    return ret;
+}
+
+std::vector<std::string> MtohRenderOverride::RendererRefreshStats(
+    TfToken rendererName) {
+    MtohRenderOverride* instance = _GetByName(rendererName);
+    if (!instance) { return {}; }
+
+    std::lock_guard<std::mutex> lock(instance->_convergenceMutex);
+    constexpr auto millisecond = 1000.0;
+    return {
+        TfStringPrintf(
+            "converged: %s", instance->_isConverged ? "true" : "false"),
+        instance->_hasRefreshTimer
+            ? TfStringPrintf(
+                  "refresh interval: %.1f ms",
+                  instance->_refreshInterval * millisecond)
+            : std::string("refresh interval: stopped"),
+        TfStringPrintf(
+            "render time: %.1f ms", instance->_renderDuration * millisecond),
+        TfStringPrintf("refreshes: %d", instance->_refreshCount),
+        TfStringPrintf("scene updates: %d", instance->_sceneUpdateCount),
+        TfStringPrintf("reused frames: %d", instance->_reusedFrameCount),
+        TfStringPrintf("resolution scale: %.2f", instance->_resolutionScale),
+        TfStringPrintf("render threads: %d", instance->_renderConcurrency)};
+}
+
+std::vector<std::string> MtohRenderOverride::RendererPipelineStats(
+    TfToken rendererName) {
+    MtohRenderOverride* instance = _GetByName(rendererName);
+    if (!instance) { return {}; }
+
+    auto latency = 0;
+    auto stagedCount = 0;
+    for (const auto& it : instance->_delegates) {
+        latency = std::max(latency, it->GetPipelineLatency());
+        stagedCount += it->GetPipelineStagedCount();
+    }
+    std::lock_guard<std::mutex> lock(instance->_convergenceMutex);
+    return {
+        TfStringPrintf(
+            "pipelined playback: %s",
+            instance->_globals.delegateParams.pipelinedPlayback ? "on"
+                                                                : "off"),
+        TfStringPrintf("latency: %d frames", latency),
+        TfStringPrintf("staged prims: %d", stagedCount),
+        TfStringPrintf(
+            "playback frame rate: %.1f fps", instance->_playbackFrameRate)};
+}
+
+std::vector<std::string> MtohRenderOverride::RendererCallbackStats(
+    TfToken rendererName) {
+    MtohRenderOverride* instance = _GetByName(rendererName);
+    if (!instance) { return {}; }
+
+    std::lock_guard<std::mutex> lock(instance->_convergenceMutex);
+    auto callbacks = instance->_callbacks.size() +
+                     (instance->_hasRefreshTimer ? 1 : 0);
+    for (const auto& it : instance->_renderPanelCallbacks) {
+        callbacks += it.second.length();
+    }
+    return {
+        TfStringPrintf(
+            "active: %s", instance->_hasCallbacks ? "true" : "false"),
+        TfStringPrintf("callbacks: %zu", callbacks),
+        TfStringPrintf(
+            "callback invocations: %d", instance->_callbackInvocations)};
+}
+
+int MtohRenderOverride::RendererShadowMapRenders(TfToken rendererName) {
+    MtohRenderOverride* instance = _GetByName(rendererName);
+    if (!instance) { return 0; }
+    return instance->_shadowMapRenders;
+}
+
 void MtohRenderOverride::_DetectMayaDefaultLighting(
     const MHWRender::MDrawContext& drawContext) {
     constexpr auto considerAllSceneLights =
@@ -354,26 +598,49 @@ void MtohRenderOverride::_DetectMayaDefaultLighting(
 
     if (foundMayaDefaultLight != _hasDefaultLighting) {
         _hasDefaultLighting = foundMayaDefaultLight;
-        _needsClear.store(true);
         TF_DEBUG(HDMAYA_RENDEROVERRIDE_DEFAULT_LIGHTING)
             .Msg(
                 "MtohRenderOverride::"
-                "_DetectMayaDefaultLighting() clearing! "
+                "_DetectMayaDefaultLighting() toggling! "
                 "_hasDefaultLighting=%i\n",
                 _hasDefaultLighting);
+        if (_initializedViewport) { _UpdateDefaultLighting(); }
+    }
+}
+
+void MtohRenderOverride::_UpdateDefaultLighting() {
+    // Only the light sprims change, the rest of the render index is kept.
+    for (auto& it : _delegates) { it->SetLightsEnabled(!_hasDefaultLighting); }
+    if (!_hasDefaultLighting) {
+        _defaultLightDelegate.reset();
+        return;
     }
+    if (_defaultLightDelegate != nullptr) { return; }
+    HdMayaDelegate::InitData delegateInitData(
+        TfToken(), _engine, _renderIndex, _rendererPlugin, _taskController,
+        _ID.AppendChild(
+            TfToken(TfStringPrintf("_DefaultLightDelegate_%p", this))),
+        _isUsingHdSt);
+    _defaultLightDelegate.reset(new MtohDefaultLightDelegate(delegateInitData));
+    _defaultLightDelegate->SetRenderIndexBusyCallback(
+        [this]() -> bool { return _IsRenderThreadBusy(); });
+    _defaultLightDelegate->Populate();
 }
 
 void MtohRenderOverride::_UpdateRenderGlobals() {
     if (!_renderGlobalsHaveChanged) { return; }
     _renderGlobalsHaveChanged = false;
     _globals = MtohGetRenderGlobals();
+    ++_renderGlobalsVersion;
+    if (!_globals.reuseUnchangedFrames) { _frameCache.Clear(); }
     _UpdateRenderDelegateOptions();
     if (_isUsingHdSt && !_operations.empty()) {
         const auto vp2Overlay = _globals.selectionOverlay == MtohTokens->UseVp2;
         auto* mayaRender = reinterpret_cast<HdMayaSceneRender*>(_operations[0]);
         if (mayaRender->_drawSelectionOverlay != vp2Overlay) {
             mayaRender->_drawSelectionOverlay = vp2Overlay;
+            // VP2 hands over another GL state once it draws the overlay.
+            _glStateShadow.Clear();
             MGlobal::executeCommandOnIdle("refresh -f;");
         }
     }
@@ -411,14 +678,33 @@ MStatus MtohRenderOverride::Render(const MHWRender::MDrawContext& drawContext) {
     // }
     TF_DEBUG(HDMAYA_RENDEROVERRIDE_RENDER)
         .Msg("MtohRenderOverride::Render()\n");
-    auto renderFrame = [&]() {
+    const auto renderStartTime = std::chrono::system_clock::now();
+    // The render thread executes tasks of the render index, so the scene,
+    // the render globals and the lighting are only updated once it
+    // finished. Until then the last frame is presented, and the refresh
+    // timer keeps redrawing.
+    if (_IsRenderThreadBusy()) {
+        _PresentWhileRendering(drawContext);
+        return MStatus::kSuccess;
+    }
+    for (auto& it : _delegates) { it->ApplyDeferredEdits(); }
+    if (_defaultLightDelegate != nullptr) {
+        _defaultLightDelegate->ApplyDeferredEdits();
+    }
+
+    auto getTasks = [&](bool renderShadows) -> HdTaskSharedPtrVector {
         const auto originX = 0;
         const auto originY = 0;
         int width = 0;
         int height = 0;
         drawContext.getRenderTargetSize(width, height);
 
-        GfVec4d viewport(originX, originY, width, height);
+        // Renderers other than HdSt render to render buffers, that are
+        // upscaled when presented.
+        GfVec4d viewport(
+            originX, originY,
+            std::max(1, static_cast<int>(width * _resolutionScale)),
+            std::max(1, static_cast<int>(height * _resolutionScale)));
 #ifdef HDMAYA_USD_001910_BUILD
         _taskController->SetFreeCameraMatrices(
 #else
@@ -436,24 +722,50 @@ MStatus MtohRenderOverride::Render(const MHWRender::MDrawContext& drawContext) {
 
 #ifdef HDMAYA_USD_001907_BUILD
         auto tasks = _taskController->GetRenderingTasks();
-        _engine.Execute(_renderIndex, &tasks);
 #else
 #ifdef HDMAYA_USD_001901_BUILD
-        _engine.Execute(*_renderIndex, _taskController->GetTasks());
+        auto tasks = _taskController->GetTasks();
 #else
-        _engine.Execute(
-            *_renderIndex,
-            _taskController->GetTasks(HdxTaskSetTokens->colorRender));
+        auto tasks = _taskController->GetTasks(HdxTaskSetTokens->colorRender);
 #endif // HDMAYA_USD_001901_BUILD
 #endif // HDMAYA_USD_001907_BUILD
+        // The shadow maps rendered in an earlier frame are still bound by the
+        // light task, so they are reused unless a shadow changed.
+        if (!renderShadows) {
+            tasks.erase(
+                std::remove_if(
+                    tasks.begin(), tasks.end(),
+                    [](const HdTaskSharedPtr& task) -> bool {
+                        return std::dynamic_pointer_cast<HdxShadowTask>(
+                                   task) != nullptr;
+                    }),
+                tasks.end());
+        }
+        return tasks;
     };
+    auto renderFrame = [&](bool renderShadows) {
+        auto tasks = getTasks(renderShadows);
+        // Keep Hydra from taking the cores Maya evaluates the scene with.
+        _renderArena->execute([&]() {
+#ifdef HDMAYA_USD_001907_BUILD
+            _engine.Execute(_renderIndex, &tasks);
+#else
+            _engine.Execute(*_renderIndex, tasks);
+#endif // HDMAYA_USD_001907_BUILD
+        });
+    };
+
+    // The scene is only updated by the first panel rendered in a refresh,
+    // the other panels only render their camera.
+    auto updateScene = _StartSceneUpdate(renderStartTime);
 
     _UpdateRenderGlobals();
 
     _DetectMayaDefaultLighting(drawContext);
-    if (_needsClear.exchange(false)) { ClearHydraResources(); }
+    if (_needsClear.exchange(false)) { ClearHydraResources(true); }
 
     if (!_initializedViewport) {
+        updateScene = true;
         _InitHydraResources();
 // This was required to work around an issue in HdSt
 // that didn't render lights the first time. Leaving it here
@@ -461,26 +773,70 @@ MStatus MtohRenderOverride::Render(const MHWRender::MDrawContext& drawContext) {
 #if 0
         if (_isUsingHdSt) {
             _taskController->SetEnableShadows(false);
-            renderFrame();
+            renderFrame(true);
             _taskController->SetEnableShadows(true);
         }
 #endif
     }
 
+    auto glStateMatches = true;
+    const auto glState = _glStateShadow.Get(
+        _currentPanel.asChar(), TfGetEnvSetting(MTOH_VALIDATE_GL_STATE),
+        glStateMatches);
+    if (!glStateMatches) {
+        TF_WARN(
+            "MtohRenderOverride::Render(%s) -- The GL state handed over by VP2 "
+            "differs from its shadow copy.",
+            _currentPanel.asChar());
+    }
     UBOBindingsSaver bindingsSaver;
 
     _SelectionChanged();
 
-    const auto displayStyle = drawContext.getDisplayStyle();
-    _globals.delegateParams.displaySmoothMeshes =
-        !(displayStyle & MHWRender::MFrameContext::kFlatShaded);
-
     if (_defaultLightDelegate != nullptr) {
         _defaultLightDelegate->SetDefaultLight(_defaultLight);
     }
-    for (auto& it : _delegates) {
-        it->SetParams(_globals.delegateParams);
-        it->PreFrame(drawContext);
+    if (updateScene) {
+        const auto displayStyle = drawContext.getDisplayStyle();
+        _globals.delegateParams.displaySmoothMeshes =
+            !(displayStyle & MHWRender::MFrameContext::kFlatShaded);
+        // Interactive edits are shown without the latency of the pipeline.
+        const auto isPlaying = MAnimControl::isPlaying();
+        _globals.delegateParams.pipelinedPlayback =
+            _globals.pipelinedPlayback && isPlaying;
+        // The delegates restore the prims the profile changed once playback
+        // stops.
+        _globals.delegateParams.playbackProfile =
+            _globals.playbackProfile && isPlaying;
+        {
+            std::lock_guard<std::mutex> lock(_convergenceMutex);
+            if (!isPlaying) {
+                _playbackFrameRate = 0.0f;
+            } else if (
+                _lastPlaybackFrameTime.time_since_epoch().count() != 0) {
+                const auto frameTime = std::chrono::duration<float>(
+                                           renderStartTime -
+                                           _lastPlaybackFrameTime)
+                                           .count();
+                if (frameTime > 0.0f) {
+                    constexpr auto smoothing = 0.1f;
+                    const auto frameRate = 1.0f / frameTime;
+                    _playbackFrameRate =
+                        _playbackFrameRate == 0.0f
+                            ? frameRate
+                            : _playbackFrameRate +
+                                  (frameRate - _playbackFrameRate) * smoothing;
+                }
+            }
+            _lastPlaybackFrameTime =
+                isPlaying ? renderStartTime
+                          : std::chrono::system_clock::time_point();
+        }
+        for (auto& it : _delegates) {
+            it->SetParams(_globals.delegateParams);
+            it->PreFrame(drawContext);
+        }
+        ++_sceneUpdateCount;
     }
 
     // TODO: Is there a way to improve this? Quite silly.
@@ -496,8 +852,41 @@ MStatus MtohRenderOverride::Render(const MHWRender::MDrawContext& drawContext) {
             enableShadows = intVals[0] != 0;
         }
     }
+    if (_globals.delegateParams.playbackProfile && !_globals.playbackShadows) {
+        enableShadows = false;
+    }
     _taskController->SetEnableShadows(enableShadows);
 
+    // Shadow maps are only rendered again when a shadowed light or one of
+    // its casters changed, for example not when only the camera moves.
+    auto shadowsTracked = _isUsingHdSt && enableShadows;
+    size_t shadowVersion = 0;
+    for (auto& it : _delegates) {
+        size_t delegateShadowVersion = 0;
+        if (!it->GetShadowVersion(delegateShadowVersion)) {
+            shadowsTracked = false;
+            break;
+        }
+        boost::hash_combine(shadowVersion, delegateShadowVersion);
+    }
+    if (shadowsTracked && _defaultLightDelegate != nullptr) {
+        size_t delegateShadowVersion = 0;
+        if (_defaultLightDelegate->GetShadowVersion(delegateShadowVersion)) {
+            boost::hash_combine(shadowVersion, delegateShadowVersion);
+        } else {
+            shadowsTracked = false;
+        }
+    }
+    const auto renderShadows = !shadowsTracked || !_hasShadowVersion ||
+                               shadowVersion != _shadowVersion;
+    _hasShadowVersion = shadowsTracked;
+    _shadowVersion = shadowVersion;
+    if (renderShadows && enableShadows) { ++_shadowMapRenders; }
+    TF_DEBUG(HDMAYA_RENDEROVERRIDE_SHADOWS)
+        .Msg(
+            "MtohRenderOverride::Render() - %s shadow maps\n",
+            renderShadows ? "rendering" : "reusing");
+
     HdxRenderTaskParams params;
     params.enableLighting = true;
     params.enableSceneMaterials = true;
@@ -535,13 +924,74 @@ MStatus MtohRenderOverride::Render(const MHWRender::MDrawContext& drawContext) {
     // We should fix this upstream, so HdStorm can setup
     // all the required states.
     _taskController->SetCollection(_renderCollection);
+
+    // Maya redraws the viewports for many reasons unrelated to the scene,
+    // the last frame is presented again if none of its inputs changed.
+    // Converging renderers need every frame rendered.
+    HdMayaFrameCache::Targets frameCacheTargets;
+    auto frameFingerprint = [&]() -> size_t {
+        // The panels share the copies between the overrides.
+        size_t fingerprint = 0;
+        boost::hash_combine(fingerprint, this);
+        boost::hash_combine(
+            fingerprint, GetGfMatrixFromMaya(drawContext.getMatrix(
+                             MHWRender::MFrameContext::kViewMtx)));
+        boost::hash_combine(
+            fingerprint, GetGfMatrixFromMaya(drawContext.getMatrix(
+                             MHWRender::MFrameContext::kProjectionMtx)));
+        boost::hash_combine(fingerprint, drawContext.getDisplayStyle());
+        boost::hash_combine(fingerprint, params.wireframeColor);
+        boost::hash_combine(fingerprint, enableShadows);
+        boost::hash_combine(fingerprint, _renderGlobalsVersion);
+        boost::hash_combine(fingerprint, _resolutionScale);
+        boost::hash_combine(fingerprint, _selectionTracker->GetVersion());
+        boost::hash_combine(
+            fingerprint,
+            _renderIndex->GetChangeTracker().GetSceneStateVersion());
+        boost::hash_combine(fingerprint, _hasDefaultLighting);
+        if (_hasDefaultLighting) {
+            boost::hash_combine(fingerprint, _defaultLight.GetPosition());
+            boost::hash_combine(fingerprint, _defaultLight.GetDiffuse());
+            boost::hash_combine(fingerprint, _defaultLight.GetSpecular());
+        }
+        return fingerprint;
+    };
+    const auto fingerprint = frameFingerprint();
+    auto& panelFingerprint = _panelFingerprints[_currentPanel.asChar()];
+    if (fingerprint != panelFingerprint) { _lastChangeTime = renderStartTime; }
+    if (_globals.reuseUnchangedFrames) {
+        frameCacheTargets = _GetFrameCacheTargets(drawContext);
+        if (_isConverged &&
+            _frameCache.Present(
+                _currentPanel.asChar(), fingerprint, frameCacheTargets)) {
+            TF_DEBUG(HDMAYA_RENDEROVERRIDE_RENDER)
+                .Msg("MtohRenderOverride::Render() - reusing frame\n");
+            // Points might still be extracted from Maya's memory.
+            for (auto& it : _delegates) { it->PostFrame(); }
+            std::lock_guard<std::mutex> lock(_convergenceMutex);
+            _lastRenderTime = std::chrono::system_clock::now();
+            _refreshPending = false;
+            ++_reusedFrameCount;
+            return MStatus::kSuccess;
+        }
+    }
+    _UpdateResolutionScale(renderStartTime);
+    _UpdateRenderArena(renderStartTime);
+
+#ifdef HDMAYA_USD_001907_BUILD
+    const auto useRenderThread = !_isUsingHdSt && _globals.renderThread;
+#else
+    const auto useRenderThread = false;
+#endif // HDMAYA_USD_001907_BUILD
     if (_isUsingHdSt) {
 #ifndef HDMAYA_OIT_ENABLED
-        HdMayaSetRenderGLState state;
+        HdMayaSetRenderGLState state(glState);
 #endif
-        renderFrame();
+        renderFrame(renderShadows);
+    } else if (useRenderThread) {
+        _RenderOnThread(getTasks(renderShadows), drawContext, frameFingerprint);
     } else {
-        renderFrame();
+        renderFrame(renderShadows);
     }
 
     // This causes issues with the embree delegate and potentially others.
@@ -549,20 +999,259 @@ MStatus MtohRenderOverride::Render(const MHWRender::MDrawContext& drawContext) {
         _globals.selectionOverlay == MtohTokens->UseHdSt && _isUsingHdSt) {
         if (!_selectionCollection.GetRootPaths().empty()) {
             _taskController->SetCollection(_selectionCollection);
-            renderFrame();
+            renderFrame(false);
             _taskController->SetCollection(_renderCollection);
         }
     }
 
+    // The fingerprint is taken after rendering, as syncing the render index
+    // might change the scene state.
+    panelFingerprint = frameFingerprint();
+    if (_globals.reuseUnchangedFrames && !useRenderThread) {
+        _frameCache.Store(
+            _currentPanel.asChar(), panelFingerprint, frameCacheTargets);
+    }
+
     for (auto& it : _delegates) { it->PostFrame(); }
 
     std::lock_guard<std::mutex> lock(_convergenceMutex);
     _lastRenderTime = std::chrono::system_clock::now();
+    const auto renderDuration =
+        std::chrono::duration<float>(_lastRenderTime - renderStartTime)
+            .count();
+    // Smooth the render time, so a single slow frame doesn't change the
+    // refresh interval.
+    _renderDuration = _renderDuration <= 0.0f
+                          ? renderDuration
+                          : 0.75f * _renderDuration + 0.25f * renderDuration;
+    _refreshPending = false;
     _isConverged = _taskController->IsConverged();
+    for (auto& it : _delegates) { _isConverged &= it->IsConverged(); }
+    // Frames rendered at a lower resolution are refined once the interaction
+    // stops.
+    if (_resolutionScale < _globals.maximumResolutionScale) {
+        _isConverged = false;
+    }
+    // The frame rendered by the render thread is presented by a later
+    // refresh, and panels waiting for the render thread render after that.
+    if (_IsRenderThreadBusy() || _renderThreadResultPending ||
+        !_renderThreadWaitingPanels.empty()) {
+        _isConverged = false;
+    }
+    _UpdateRefreshTimer();
 
     return MStatus::kSuccess;
 }
 
+bool MtohRenderOverride::_StartSceneUpdate(
+    std::chrono::system_clock::time_point renderStartTime) {
+    const auto panelRendered =
+        std::find(
+            _panelsSinceSceneUpdate.begin(), _panelsSinceSceneUpdate.end(),
+            _currentPanel) != _panelsSinceSceneUpdate.end();
+    const auto updateScene = panelRendered || _panelsSinceSceneUpdate.empty() ||
+                             renderStartTime - _lastRenderTime > _refreshGap;
+    if (updateScene) { _panelsSinceSceneUpdate.clear(); }
+    _panelsSinceSceneUpdate.push_back(_currentPanel);
+    return updateScene;
+}
+
+void MtohRenderOverride::_UpdateResolutionScale(
+    std::chrono::system_clock::time_point renderStartTime) {
+    if (_isUsingHdSt || !_globals.dynamicResolution) {
+        _resolutionScale = 1.0f;
+        return;
+    }
+    const auto maximumScale = _globals.maximumResolutionScale;
+    const auto minimumScale =
+        std::min(_globals.minimumResolutionScale, maximumScale);
+    if (renderStartTime - _lastChangeTime > _refineDelay ||
+        _renderDuration <= 0.0f) {
+        _resolutionScale = maximumScale;
+        return;
+    }
+    // The render time scales roughly with the number of pixels.
+    const auto scale = std::min(
+        maximumScale,
+        std::max(
+            minimumScale,
+            _resolutionScale * std::sqrt(
+                                   _globals.targetFrameTime * 0.001f /
+                                   _renderDuration)));
+    // The render buffers are only resized for larger changes of the scale.
+    if (std::abs(scale - _resolutionScale) > 0.1f * _resolutionScale ||
+        _resolutionScale > maximumScale || _resolutionScale < minimumScale) {
+        _resolutionScale = scale;
+    }
+}
+
+void MtohRenderOverride::_UpdateRenderArena(
+    std::chrono::system_clock::time_point renderStartTime) {
+    const auto cores = tbb::task_scheduler_init::default_num_threads();
+    auto concurrency = _globals.renderThreadLimit > 0
+                           ? std::min(_globals.renderThreadLimit, cores)
+                           : cores;
+    // Maya evaluates the scene in parallel during playback and manipulation,
+    // half of the cores are left for the evaluation.
+    if (MAnimControl::isPlaying() ||
+        renderStartTime - _lastChangeTime < _refineDelay) {
+        concurrency = std::max(1, std::min(concurrency, cores / 2));
+    }
+    if (_renderArena != nullptr && concurrency == _renderConcurrency) {
+        return;
+    }
+#ifdef HDMAYA_USD_001907_BUILD
+    // The render thread executes its tasks in the arena.
+    if (_renderThread.IsRendering()) { return; }
+#endif // HDMAYA_USD_001907_BUILD
+    TF_DEBUG(HDMAYA_RENDEROVERRIDE_RENDER)
+        .Msg(
+            "MtohRenderOverride::_UpdateRenderArena() - %d threads\n",
+            concurrency);
+    _renderArena.reset(new tbb::task_arena(concurrency));
+    _renderConcurrency = concurrency;
+}
+
+void MtohRenderOverride::_RenderOnThread(
+    HdTaskSharedPtrVector tasks, const MHWRender::MDrawContext& drawContext,
+    const std::function<size_t()>& fingerprint) {
+#ifdef HDMAYA_USD_001907_BUILD
+    const std::string panel = _currentPanel.asChar();
+    const auto targets = _GetFrameCacheTargets(drawContext);
+    // The render buffers hold the frame of a single panel, which presents it
+    // when it is drawn later in the same refresh. Other panels wait for the
+    // render thread until then.
+    if (_renderThreadResultPending && _renderThreadPanel != panel) {
+        _frameCache.Present(panel, targets);
+        _renderThreadWaitingPanels.insert(panel);
+        return;
+    }
+    if (_renderThreadPanel == panel) {
+        if (_renderThreadResultPending) {
+            for (auto& task : _renderThreadPresentTasks) {
+                task->Execute(&_renderThreadContext);
+            }
+            _frameCache.Store(panel, _renderThreadFingerprint, targets);
+            _renderThreadResultPending = false;
+        } else {
+            _frameCache.Present(panel, targets);
+            // None of the waiting panels was drawn since the last frame
+            // finished, for example because they are hidden.
+            _renderThreadWaitingPanels.clear();
+        }
+        // The panel keeps the render thread until its frame converged, then
+        // the waiting panels render theirs.
+        if (fingerprint() == _renderThreadFingerprint &&
+            _taskController->IsConverged()) {
+            return;
+        }
+    } else {
+        _renderThreadWaitingPanels.erase(panel);
+        // The panel presents its last frame until the new one finished, and
+        // isn't rendered again if nothing changed since.
+        if (_frameCache.Present(panel, fingerprint(), targets)) { return; }
+        _frameCache.Present(panel, targets);
+    }
+
+    _renderThreadContext[HdxTokens->selectionState] =
+        VtValue(_selectionTracker);
+    _renderIndex->SyncAll(&tasks, &_renderThreadContext);
+    for (auto& task : tasks) {
+        task->Prepare(&_renderThreadContext, _renderIndex);
+    }
+    _renderIndex->GetRenderDelegate()->CommitResources(
+        &_renderIndex->GetChangeTracker());
+
+    // The render tasks are executed on the render thread, the tasks after
+    // the last one present their render buffers once it finished. The other
+    // tasks are executed right away.
+    const auto lastRenderTask =
+        std::find_if(
+            tasks.rbegin(), tasks.rend(),
+            [](const HdTaskSharedPtr& task) -> bool {
+                return std::dynamic_pointer_cast<HdxRenderTask>(task) !=
+                       nullptr;
+            })
+            .base();
+    _renderThreadTasks.clear();
+    for (auto it = tasks.begin(); it != lastRenderTask; ++it) {
+        if (std::dynamic_pointer_cast<HdxRenderTask>(*it) != nullptr) {
+            _renderThreadTasks.push_back(*it);
+        } else {
+            (*it)->Execute(&_renderThreadContext);
+        }
+    }
+    _renderThreadPresentTasks.assign(lastRenderTask, tasks.end());
+    _renderThreadPanel = panel;
+    _renderThreadFingerprint = fingerprint();
+    _renderThreadResultPending = true;
+    if (!_renderThread.IsThreadRunning()) {
+        _renderThread.SetRenderCallback([this]() {
+            _renderArena->execute([this]() {
+                for (auto& task : _renderThreadTasks) {
+                    task->Execute(&_renderThreadContext);
+                }
+            });
+        });
+        _renderThread.StartThread();
+    }
+    _renderThread.StartRender();
+#endif // HDMAYA_USD_001907_BUILD
+}
+
+bool MtohRenderOverride::_IsRenderThreadBusy() {
+#ifdef HDMAYA_USD_001907_BUILD
+    return _renderThread.IsRendering();
+#else
+    return false;
+#endif // HDMAYA_USD_001907_BUILD
+}
+
+void MtohRenderOverride::_PresentWhileRendering(
+    const MHWRender::MDrawContext& drawContext) {
+    const std::string panel = _currentPanel.asChar();
+    _frameCache.Present(panel, _GetFrameCacheTargets(drawContext));
+    if (panel != _renderThreadPanel) {
+        _renderThreadWaitingPanels.insert(panel);
+    }
+    std::lock_guard<std::mutex> lock(_convergenceMutex);
+    _lastRenderTime = std::chrono::system_clock::now();
+    _refreshPending = false;
+    _isConverged = false;
+    _UpdateRefreshTimer();
+}
+
+void MtohRenderOverride::_UpdateRefreshTimer() {
+    if (_isConverged) {
+        _RemoveRefreshTimer();
+        return;
+    }
+    const auto refreshInterval = std::min(
+        _maxRefreshInterval,
+        std::max(_minRefreshInterval, _renderDuration / _refreshDutyCycle));
+    // Timer callbacks are only added again for larger changes of the
+    // interval.
+    if (_hasRefreshTimer &&
+        std::abs(refreshInterval - _refreshInterval) <
+            0.25f * _refreshInterval) {
+        return;
+    }
+    _RemoveRefreshTimer();
+    MStatus status;
+    const auto id = MTimerMessage::addTimerCallback(
+        refreshInterval, _TimerCallback, this, &status);
+    if (!status) { return; }
+    _refreshTimer = id;
+    _refreshInterval = refreshInterval;
+    _hasRefreshTimer = true;
+}
+
+void MtohRenderOverride::_RemoveRefreshTimer() {
+    if (!_hasRefreshTimer) { return; }
+    MMessage::removeCallback(_refreshTimer);
+    _hasRefreshTimer = false;
+}
+
 MtohRenderOverride* MtohRenderOverride::_GetByName(TfToken rendererName) {
     std::lock_guard<std::mutex> lock(_allInstancesMutex);
     for (auto* instance : _allInstances) {
@@ -582,11 +1271,17 @@ void MtohRenderOverride::_InitHydraResources() {
 #ifdef HDMAYA_USD_001905_BUILD
     GlfContextCaps::InitInstance();
 #endif
-    _rendererPlugin =
-        HdxRendererPluginRegistry::GetInstance().GetRendererPlugin(
-            _rendererDesc.rendererName);
-    auto* renderDelegate = _rendererPlugin->CreateRenderDelegate();
-    _renderIndex = HdRenderIndex::New(renderDelegate);
+    if (_renderDelegate == nullptr) {
+        _rendererPlugin =
+            HdxRendererPluginRegistry::GetInstance().GetRendererPlugin(
+                _rendererDesc.rendererName);
+        _renderDelegate = _rendererPlugin->CreateRenderDelegate();
+    } else {
+        // The render delegate is still destroying the prims of the previous
+        // render index.
+        _renderIndexTeardown.wait();
+    }
+    _renderIndex = HdRenderIndex::New(_renderDelegate);
 
     _taskController = new HdxTaskController(
         _renderIndex,
@@ -613,20 +1308,16 @@ void MtohRenderOverride::_InitHydraResources() {
         if (newDelegate) {
             // Call SetLightsEnabled before the delegate is populated
             newDelegate->SetLightsEnabled(!_hasDefaultLighting);
+            newDelegate->SetRenderIndexBusyCallback(
+                [this]() -> bool { return _IsRenderThreadBusy(); });
             _delegates.push_back(newDelegate);
         }
     }
-    if (_hasDefaultLighting) {
-        delegateInitData.delegateID = _ID.AppendChild(
-            TfToken(TfStringPrintf("_DefaultLightDelegate_%p", this)));
-        _defaultLightDelegate.reset(
-            new MtohDefaultLightDelegate(delegateInitData));
-    }
     VtValue selectionTrackerValue(_selectionTracker);
     _engine.SetTaskContextData(
         HdxTokens->selectionState, selectionTrackerValue);
     for (auto& it : _delegates) { it->Populate(); }
-    if (_defaultLightDelegate) { _defaultLightDelegate->Populate(); }
+    if (_hasDefaultLighting) { _UpdateDefaultLighting(); }
 
     _renderIndex->GetChangeTracker().AddCollection(
         _selectionCollection.GetName());
@@ -636,14 +1327,33 @@ void MtohRenderOverride::_InitHydraResources() {
     _UpdateRenderDelegateOptions();
 }
 
-void MtohRenderOverride::ClearHydraResources() {
-    if (!_initializedViewport) { return; }
+void MtohRenderOverride::ClearHydraResources(bool keepRenderDelegate) {
+    if (!_initializedViewport) {
+        if (!keepRenderDelegate) { _ReleaseRenderDelegate(); }
+        return;
+    }
 
     TF_DEBUG(HDMAYA_RENDEROVERRIDE_RESOURCES)
         .Msg(
             "MtohRenderOverride::ClearHydraResources(%s)\n",
             _rendererDesc.rendererName.GetText());
 
+#ifdef HDMAYA_USD_001907_BUILD
+    // The render thread executes tasks of the render index.
+    if (_renderThread.IsThreadRunning()) {
+        _renderThread.StopRender();
+        _renderThread.StopThread();
+    }
+    _renderThreadTasks.clear();
+    _renderThreadPresentTasks.clear();
+    _renderThreadContext.clear();
+    _renderThreadPanel.clear();
+    _renderThreadResultPending = false;
+    _renderThreadWaitingPanels.clear();
+#endif // HDMAYA_USD_001907_BUILD
+
+    // The adapters hold Maya objects, so they are released on the main
+    // thread along with their callbacks.
     _delegates.clear();
     _defaultLightDelegate.reset();
 
@@ -652,26 +1362,63 @@ void MtohRenderOverride::ClearHydraResources() {
         _taskController = nullptr;
     }
 
-    HdRenderDelegate* renderDelegate = nullptr;
     if (_renderIndex != nullptr) {
-        renderDelegate = _renderIndex->GetRenderDelegate();
-        delete _renderIndex;
+        if (_isUsingHdSt) {
+            // HdSt prims might release GL resources, which requires the
+            // context of the viewport.
+            delete _renderIndex;
+        } else {
+            // Maya starts loading the next scene while the prims of huge
+            // scenes are destroyed.
+            auto* renderIndex = _renderIndex;
+            _renderIndexTeardown.run([renderIndex]() {
+                TfStopwatch stopwatch;
+                stopwatch.Start();
+                delete renderIndex;
+                stopwatch.Stop();
+                TF_DEBUG(HDMAYA_RENDEROVERRIDE_RESOURCES)
+                    .Msg(
+                        "Render index destroyed in the background in %.1f "
+                        "ms\n",
+                        stopwatch.GetMilliseconds());
+            });
+        }
         _renderIndex = nullptr;
     }
 
+    if (!keepRenderDelegate) { _ReleaseRenderDelegate(); }
+
+    _initializedViewport = false;
+    _hasShadowVersion = false;
+    _frameCache.Clear();
+    _panelFingerprints.clear();
+    _glStateShadow.Clear();
+    SelectionChanged();
+}
+
+void MtohRenderOverride::_ReleaseRenderDelegate() {
+    _renderIndexTeardown.wait();
     if (_rendererPlugin != nullptr) {
-        if (renderDelegate != nullptr) {
-            _rendererPlugin->DeleteRenderDelegate(renderDelegate);
+        if (_renderDelegate != nullptr) {
+            _rendererPlugin->DeleteRenderDelegate(_renderDelegate);
         }
         HdxRendererPluginRegistry::GetInstance().ReleasePlugin(_rendererPlugin);
         _rendererPlugin = nullptr;
     }
-
-    _initializedViewport = false;
-    SelectionChanged();
+    _renderDelegate = nullptr;
 }
 
 void MtohRenderOverride::_RemovePanel(MString panelName) {
+    _panelsSinceSceneUpdate.erase(
+        std::remove(
+            _panelsSinceSceneUpdate.begin(), _panelsSinceSceneUpdate.end(),
+            panelName),
+        _panelsSinceSceneUpdate.end());
+    _panelFingerprints.erase(panelName.asChar());
+    _renderThreadWaitingPanels.erase(panelName.asChar());
+    if (_renderThreadPanel == panelName.asChar()) {
+        _renderThreadResultPending = false;
+    }
     auto foundPanelCallbacks = _FindPanelCallbacks(panelName);
     if (foundPanelCallbacks != _renderPanelCallbacks.end()) {
         MMessage::removeCallbacks(foundPanelCallbacks->second);
@@ -681,6 +1428,8 @@ void MtohRenderOverride::_RemovePanel(MString panelName) {
     if (_renderPanelCallbacks.empty()) {
         ClearHydraResources();
         _UpdateRenderGlobals();
+        // Overrides not used by any panel don't cost Maya anything.
+        _DetachCallbacks();
     }
 }
 
@@ -712,7 +1461,13 @@ void MtohRenderOverride::_SelectionChanged() {
 #endif // HDMAYA_UFE_BUILD
         it->PopulateSelectedPaths(sel, selectedPaths, selection);
     }
-    _selectionCollection.SetRootPaths(selectedPaths);
+    // Changing the root paths makes Hydra gather the draw items of the
+    // selection collection again, so they are only set when selected prims
+    // were added or removed.
+    std::sort(selectedPaths.begin(), selectedPaths.end());
+    if (selectedPaths != _selectionCollection.GetRootPaths()) {
+        _selectionCollection.SetRootPaths(selectedPaths);
+    }
     _selectionTracker->SetSelection(HdSelectionSharedPtr(selection));
     TF_DEBUG(HDMAYA_RENDEROVERRIDE_SELECTION)
         .Msg(
@@ -727,6 +1482,8 @@ MHWRender::DrawAPI MtohRenderOverride::supportedDrawAPIs() const {
 MStatus MtohRenderOverride::setup(const MString& destination) {
     MStatus status;
 
+    _currentPanel = destination;
+
     auto panelNameAndCallbacks = _FindPanelCallbacks(destination);
     if (panelNameAndCallbacks == _renderPanelCallbacks.end()) {
         // Install the panel callbacks
@@ -745,6 +1502,7 @@ MStatus MtohRenderOverride::setup(const MString& destination) {
         if (status) { newCallbacks.append(id); }
 
         _renderPanelCallbacks.emplace_back(destination, newCallbacks);
+        _AttachCallbacks();
     }
 
     auto* renderer = MHWRender::MRenderer::theRenderer();
@@ -795,24 +1553,34 @@ bool MtohRenderOverride::nextRenderOperation() {
 void MtohRenderOverride::_ClearHydraCallback(void* data) {
     auto* instance = reinterpret_cast<MtohRenderOverride*>(data);
     if (!TF_VERIFY(instance)) { return; }
-    instance->ClearHydraResources();
+    ++instance->_callbackInvocations;
+    // The renderer is the same for the next scene.
+    instance->ClearHydraResources(true);
 }
 
 void MtohRenderOverride::_TimerCallback(float, float, void* data) {
     auto* instance = reinterpret_cast<MtohRenderOverride*>(data);
     if (!TF_VERIFY(instance)) { return; }
     std::lock_guard<std::mutex> lock(instance->_convergenceMutex);
-    if (!instance->_isConverged &&
-        (std::chrono::system_clock::now() - instance->_lastRenderTime) <
-            std::chrono::seconds(5)) {
-        MGlobal::executeCommandOnIdle("refresh -f");
+    ++instance->_callbackInvocations;
+    if (instance->_isConverged ||
+        (std::chrono::system_clock::now() - instance->_lastRenderTime) >=
+            _refreshTimeout) {
+        instance->_RemoveRefreshTimer();
+        return;
     }
+    // Refreshes are not queued up when Maya is slower than the timer.
+    if (instance->_refreshPending) { return; }
+    instance->_refreshPending = true;
+    ++instance->_refreshCount;
+    MGlobal::executeCommandOnIdle("refresh -f");
 }
 
 void MtohRenderOverride::_PanelDeletedCallback(
     const MString& panelName, void* data) {
     auto* instance = reinterpret_cast<MtohRenderOverride*>(data);
     if (!TF_VERIFY(instance)) { return; }
+    ++instance->_callbackInvocations;
 
     instance->_RemovePanel(panelName);
 }
@@ -822,6 +1590,7 @@ void MtohRenderOverride::_RendererChangedCallback(
     const MString& newRenderer, void* data) {
     auto* instance = reinterpret_cast<MtohRenderOverride*>(data);
     if (!TF_VERIFY(instance)) { return; }
+    ++instance->_callbackInvocations;
 
     if (newRenderer != oldRenderer) { instance->_RemovePanel(panelName); }
 }
@@ -831,6 +1600,7 @@ void MtohRenderOverride::_RenderOverrideChangedCallback(
     const MString& newOverride, void* data) {
     auto* instance = reinterpret_cast<MtohRenderOverride*>(data);
     if (!TF_VERIFY(instance)) { return; }
+    ++instance->_callbackInvocations;
 
     if (newOverride != instance->name()) { instance->_RemovePanel(panelName); }
 }
@@ -842,6 +1612,7 @@ void MtohRenderOverride::_SelectionChangedCallback(void* data) {
             "selection triggered)\n");
     auto* instance = reinterpret_cast<MtohRenderOverride*>(data);
     if (!TF_VERIFY(instance)) { return; }
+    ++instance->_callbackInvocations;
     instance->SelectionChanged();
 }
 
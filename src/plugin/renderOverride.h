@@ -33,6 +33,8 @@
 
 #include <pxr/imaging/hd/engine.h>
 #include <pxr/imaging/hd/renderIndex.h>
+#include <pxr/imaging/hd/renderThread.h>
+#include <pxr/imaging/hd/task.h>
 #include <pxr/imaging/hdSt/renderDelegate.h>
 
 #include <pxr/imaging/hd/engine.h>
@@ -55,7 +57,14 @@
 
 #include <atomic>
 #include <chrono>
+#include <functional>
 #include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <tbb/task_arena.h>
+#include <tbb/task_group.h>
 
 #if HDMAYA_UFE_BUILD
 #include <ufe/observer.h>
@@ -70,6 +79,10 @@ public:
 
     static void UpdateRenderGlobals();
 
+    /// Resolves the texture file paths and UDIM tiles again in all the scene
+    /// delegates.
+    static void RefreshFileTextures();
+
     /// The names of all render delegates that are being used by at least
     /// one modelEditor panel.
     static std::vector<MString> AllActiveRendererNames();
@@ -81,6 +94,12 @@ public:
     static SdfPathVector RendererRprims(
         TfToken rendererName, bool visibleOnly = false);
 
+    /// Returns the root paths of the selection collection for the given
+    /// render delegate, followed by the rprims highlighted as selected.
+    ///
+    /// Intended mostly for use in debugging and testing.
+    static std::vector<std::string> RendererSelection(TfToken rendererName);
+
     /// Returns the scene delegate id for the given render delegate and
     /// scene delegate names.
     ///
@@ -88,9 +107,62 @@ public:
     static SdfPath RendererSceneDelegateId(
         TfToken rendererName, TfToken sceneDelegateName);
 
+    /// Returns a description of the texture memory usage of each scene
+    /// delegate for the given render delegate.
+    static std::vector<std::string> RendererTextureMemoryUsage(
+        TfToken rendererName);
+
+    /// Returns the number of shadow casters of each shadowed light for the
+    /// given render delegate.
+    ///
+    /// Intended mostly for use in debugging and testing.
+    static std::vector<std::string> RendererShadowCasterCounts(
+        TfToken rendererName);
+
+    /// Returns the number of frames the shadow maps were rendered in for the
+    /// given render delegate, frames reusing the shadow maps are not counted.
+    ///
+    /// Intended mostly for use in debugging and testing.
+    static int RendererShadowMapRenders(TfToken rendererName);
+
+    /// Returns the state of the refresh scheduler for the given render
+    /// delegate: convergence, refresh interval, smoothed render time, the
+    /// number of refreshes it requested, the number of scene updates, the
+    /// number of frames presented again instead of rendering them, the
+    /// current resolution scale and the number of threads Hydra is executed
+    /// with.
+    ///
+    /// Intended mostly for use in debugging and testing.
+    static std::vector<std::string> RendererRefreshStats(
+        TfToken rendererName);
+
+    /// Returns the state of pipelined playback for the given render
+    /// delegate: whether it is active, the number of frames the rendered
+    /// scene lags behind Maya, the number of prims drawn from staged data and
+    /// the playback frame rate.
+    ///
+    /// Intended mostly for use in debugging and testing.
+    static std::vector<std::string> RendererPipelineStats(
+        TfToken rendererName);
+
+    /// Returns whether the override for the given render delegate is used by
+    /// any panel, the number of Maya callbacks it has registered and how many
+    /// times its callbacks were invoked.
+    ///
+    /// Overrides that aren't used by any panel register no callbacks.
+    ///
+    /// Intended mostly for use in debugging and testing.
+    static std::vector<std::string> RendererCallbackStats(
+        TfToken rendererName);
+
     MStatus Render(const MHWRender::MDrawContext& drawContext);
 
-    void ClearHydraResources();
+    /// Removes the Maya callbacks of the scene and destroys the render index
+    /// and the delegates populating it.
+    ///
+    /// \param keepRenderDelegate Keep the render delegate to populate the next
+    ///  render index with, when only the scene is changing.
+    void ClearHydraResources(bool keepRenderDelegate = false);
     void SelectionChanged();
 
     MString uiName() const override {
@@ -112,12 +184,29 @@ private:
 
     static MtohRenderOverride* _GetByName(TfToken rendererName);
 
+    void _AttachCallbacks();
+    void _DetachCallbacks();
     void _InitHydraResources();
+    void _ReleaseRenderDelegate();
     void _RemovePanel(MString panelName);
     void _SelectionChanged();
     void _DetectMayaDefaultLighting(const MHWRender::MDrawContext& drawContext);
+    void _UpdateDefaultLighting();
     void _UpdateRenderGlobals();
     void _UpdateRenderDelegateOptions();
+    bool _StartSceneUpdate(
+        std::chrono::system_clock::time_point renderStartTime);
+    void _UpdateResolutionScale(
+        std::chrono::system_clock::time_point renderStartTime);
+    void _UpdateRenderArena(
+        std::chrono::system_clock::time_point renderStartTime);
+    void _RenderOnThread(
+        HdTaskSharedPtrVector tasks, const MHWRender::MDrawContext& drawContext,
+        const std::function<size_t()>& fingerprint);
+    bool _IsRenderThreadBusy();
+    void _PresentWhileRendering(const MHWRender::MDrawContext& drawContext);
+    void _UpdateRefreshTimer();
+    void _RemoveRefreshTimer();
 
     inline PanelCallbacksList::iterator _FindPanelCallbacks(MString panelName) {
         // There should never be that many render panels, so linear iteration
@@ -151,10 +240,41 @@ private:
 
     std::mutex _convergenceMutex;
     std::chrono::system_clock::time_point _lastRenderTime;
+    std::chrono::system_clock::time_point _lastChangeTime;
+    std::chrono::system_clock::time_point _lastPlaybackFrameTime;
+    MCallbackId _refreshTimer = 0;
+    float _refreshInterval = 0.0f;
+    float _renderDuration = 0.0f;
+    float _resolutionScale = 1.0f;
+    float _playbackFrameRate = 0.0f;
+    int _refreshCount = 0;
+    int _sceneUpdateCount = 0;
+    int _reusedFrameCount = 0;
+    int _callbackInvocations = 0;
+    bool _hasRefreshTimer = false;
+    bool _hasCallbacks = false;
+    bool _refreshPending = false;
     std::atomic<bool> _needsClear;
 
     HdEngine _engine;
+    std::unique_ptr<tbb::task_arena> _renderArena;
+    int _renderConcurrency = 0;
+    // Renders the render tasks of non-HdSt renderers off the main thread.
+    HdRenderThread _renderThread;
+    HdTaskContext _renderThreadContext;
+    HdTaskSharedPtrVector _renderThreadTasks;
+    HdTaskSharedPtrVector _renderThreadPresentTasks;
+    // Panel the render thread renders for, and whether the panel hasn't
+    // presented the finished frame yet.
+    std::string _renderThreadPanel;
+    size_t _renderThreadFingerprint = 0;
+    bool _renderThreadResultPending = false;
+    // Panels drawn while the render thread was used by another panel.
+    std::unordered_set<std::string> _renderThreadWaitingPanels;
     HdxRendererPlugin* _rendererPlugin = nullptr;
+    HdRenderDelegate* _renderDelegate = nullptr;
+    // Destroys the render indices of renderers other than HdSt.
+    tbb::task_group _renderIndexTeardown;
     HdxTaskController* _taskController = nullptr;
     HdRenderIndex* _renderIndex = nullptr;
     std::unique_ptr<MtohDefaultLightDelegate> _defaultLightDelegate = nullptr;
@@ -164,10 +284,18 @@ private:
     GlfSimpleLight _defaultLight;
 
     std::vector<HdMayaDelegatePtr> _delegates;
+    // Panels rendered since the scene was last updated.
+    std::vector<MString> _panelsSinceSceneUpdate;
+    MString _currentPanel;
+    // Fingerprints of the inputs of the last frame rendered to each panel.
+    std::unordered_map<std::string, size_t> _panelFingerprints;
 
     SdfPath _ID;
 
     int _currentOperation = -1;
+    int _shadowMapRenders = 0;
+    size_t _shadowVersion = 0;
+    size_t _renderGlobalsVersion = 0;
 
     const bool _isUsingHdSt = false;
     bool _initializedViewport = false;
@@ -175,6 +303,7 @@ private:
     bool _renderGlobalsHaveChanged = false;
     bool _selectionChanged = true;
     bool _isConverged = false;
+    bool _hasShadowVersion = false;
 
 #if HDMAYA_UFE_BUILD
     UFE_NS::Observer::Ptr _ufeSelectionObserver;
@@ -24,6 +24,9 @@
 #ifndef __MTOH_VIEW_OVERRIDE_UTILS_H__
 #define __MTOH_VIEW_OVERRIDE_UTILS_H__
 
+#include <string>
+#include <unordered_map>
+
 PXR_NAMESPACE_OPEN_SCOPE
 
 class HdMayaSceneRender : public MHWRender::MSceneRender {
@@ -100,39 +103,102 @@ private:
     MtohRenderOverride* _override;
 };
 
-class HdMayaSetRenderGLState {
+/// \brief Shadow copy of the GL state that is changed while rendering with
+///  Hydra, and has to be restored before handing back to VP2.
+///
+/// VP2 hands over the same state to the render operation every frame, so the
+/// state is only queried for the first frame rendered to a destination, or
+/// after the shadow copy was cleared. On some drivers each query stalls the
+/// pipeline.
+///
+/// The uniform buffer bindings are not part of the shadow copy, VP2 doesn't
+/// track them and might allocate different buffers later, see
+/// UBOBindingsSaver.
+class HdMayaGLStateShadow {
 public:
-    HdMayaSetRenderGLState() {
-        glGetIntegerv(GL_BLEND_SRC_ALPHA, &_oldBlendFunc);
-        glGetIntegerv(GL_BLEND_EQUATION_RGB, &_oldBlendEquation);
-        glGetBooleanv(GL_BLEND, &_oldBlend);
-        glGetBooleanv(GL_CULL_FACE, &_oldCullFace);
+    struct State {
+        GLint blendFunc = GL_ONE_MINUS_SRC_ALPHA;
+        GLint blendEquation = GL_FUNC_ADD;
+        GLboolean blend = GL_TRUE;
+        GLboolean cullFace = GL_FALSE;
+
+        void Query() {
+            glGetIntegerv(GL_BLEND_SRC_ALPHA, &blendFunc);
+            glGetIntegerv(GL_BLEND_EQUATION_RGB, &blendEquation);
+            glGetBooleanv(GL_BLEND, &blend);
+            glGetBooleanv(GL_CULL_FACE, &cullFace);
+        }
 
-        if (_oldBlendFunc != BLEND_FUNC) {
+        bool operator==(const State& other) const {
+            return blendFunc == other.blendFunc &&
+                   blendEquation == other.blendEquation &&
+                   blend == other.blend && cullFace == other.cullFace;
+        }
+
+        bool operator!=(const State& other) const { return !(*this == other); }
+    };
+
+    /// \brief Returns the state handed over by VP2 to a destination.
+    ///
+    /// \param destination Name of the panel or offscreen destination.
+    /// \param validate Query the state even if there is a shadow copy.
+    /// \param matches Set to false if validation found the shadow copy out of
+    ///  date, the queried state is returned in that case.
+    /// \return Shadow copy of the state.
+    const State& Get(
+        const std::string& destination, bool validate, bool& matches) {
+        matches = true;
+        auto it = _states.find(destination);
+        if (it != _states.end() && !validate) { return it->second; }
+        State state;
+        state.Query();
+        if (it == _states.end()) {
+            it = _states.emplace(destination, state).first;
+        } else if (it->second != state) {
+            matches = false;
+            it->second = state;
+        }
+        return it->second;
+    }
+
+    /// Clears the shadow copies, so the state is queried again.
+    void Clear() { _states.clear(); }
+
+private:
+    std::unordered_map<std::string, State> _states;
+};
+
+/// Sets the GL state HdSt expects when rendering without OIT, and restores
+/// the state handed over by VP2 without querying it.
+class HdMayaSetRenderGLState {
+public:
+    explicit HdMayaSetRenderGLState(const HdMayaGLStateShadow::State& old)
+        : _old(old) {
+        if (_old.blendFunc != BLEND_FUNC) {
             glBlendFunc(GL_SRC_ALPHA, BLEND_FUNC);
         }
 
-        if (_oldBlendEquation != BLEND_EQUATION) {
+        if (_old.blendEquation != BLEND_EQUATION) {
             glBlendEquation(BLEND_EQUATION);
         }
 
-        if (_oldBlend != BLEND) { glEnable(GL_BLEND); }
+        if (_old.blend != BLEND) { glEnable(GL_BLEND); }
 
-        if (_oldCullFace != CULL_FACE) { glDisable(GL_CULL_FACE); }
+        if (_old.cullFace != CULL_FACE) { glDisable(GL_CULL_FACE); }
     }
 
     ~HdMayaSetRenderGLState() {
-        if (_oldBlend != BLEND) { glDisable(GL_BLEND); }
+        if (_old.blend != BLEND) { glDisable(GL_BLEND); }
 
-        if (_oldBlendFunc != BLEND_FUNC) {
-            glBlendFunc(GL_SRC_ALPHA, _oldBlendFunc);
+        if (_old.blendFunc != BLEND_FUNC) {
+            glBlendFunc(GL_SRC_ALPHA, _old.blendFunc);
         }
 
-        if (_oldBlendEquation != BLEND_EQUATION) {
-            glBlendEquation(_oldBlendEquation);
+        if (_old.blendEquation != BLEND_EQUATION) {
+            glBlendEquation(_old.blendEquation);
         }
 
-        if (_oldCullFace != CULL_FACE) { glEnable(GL_CULL_FACE); }
+        if (_old.cullFace != CULL_FACE) { glEnable(GL_CULL_FACE); }
     }
 
 private:
@@ -142,10 +208,251 @@ private:
     constexpr static GLboolean BLEND = GL_TRUE;
     constexpr static GLboolean CULL_FACE = GL_FALSE;
 
-    int _oldBlendFunc = BLEND_FUNC;
-    int _oldBlendEquation = BLEND_EQUATION;
-    GLboolean _oldBlend = BLEND;
-    GLboolean _oldCullFace = CULL_FACE;
+    const HdMayaGLStateShadow::State& _old;
+};
+
+/// \brief Copies of the color and depth results of the last frame rendered to
+///  each destination, along with the fingerprint of the inputs of the frame.
+///
+/// Maya redraws the viewports for many reasons unrelated to the scene, like
+/// UI hover or HUD updates. When the inputs of a frame match the stored
+/// fingerprint, the copy is blitted back instead of rendering the frame.
+class HdMayaFrameCache {
+public:
+    /// Description of the render targets of a destination, the copies are
+    /// allocated again when it changes.
+    struct Targets {
+        int width = 0;
+        int height = 0;
+        int sampleCount = 0;
+        int colorFormat = 0;
+        int depthFormat = 0;
+
+        bool operator==(const Targets& other) const {
+            return width == other.width && height == other.height &&
+                   sampleCount == other.sampleCount &&
+                   colorFormat == other.colorFormat &&
+                   depthFormat == other.depthFormat;
+        }
+
+        bool operator!=(const Targets& other) const {
+            return !(*this == other);
+        }
+    };
+
+    /// \brief Blits the copy of the last frame to the bound framebuffer.
+    ///
+    /// \param destination Name of the panel or offscreen destination.
+    /// \param fingerprint Hash of the inputs of the frame.
+    /// \param targets Description of the render targets of the destination.
+    /// \return True if there was a matching copy to present.
+    bool Present(
+        const std::string& destination, size_t fingerprint,
+        const Targets& targets) {
+        auto it = _frames.find(destination);
+        if (it == _frames.end() || it->second.fingerprint != fingerprint) {
+            return false;
+        }
+        return Present(destination, targets);
+    }
+
+    /// \brief Blits the copy of the last frame to the bound framebuffer,
+    ///  regardless of the inputs of the frame.
+    ///
+    /// \param destination Name of the panel or offscreen destination.
+    /// \param targets Description of the render targets of the destination.
+    /// \return True if there was a copy to present.
+    bool Present(const std::string& destination, const Targets& targets) {
+        auto it = _frames.find(destination);
+        if (it == _frames.end()) { return false; }
+        const auto& frame = it->second;
+        if (!frame.valid || frame.targets != targets) { return false; }
+        GLint framebuffer = 0;
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &framebuffer);
+        _Blit(frame, frame.framebuffer, framebuffer);
+        return true;
+    }
+
+    /// \brief Copies the results in the bound framebuffer.
+    ///
+    /// \param destination Name of the panel or offscreen destination.
+    /// \param fingerprint Hash of the inputs of the frame.
+    /// \param targets Description of the render targets of the destination.
+    void Store(
+        const std::string& destination, size_t fingerprint,
+        const Targets& targets) {
+        GLint framebuffer = 0;
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &framebuffer);
+        auto& frame = _frames[destination];
+        frame.valid = false;
+        if (framebuffer == 0) { return; }
+        // Targets that can't be copied are not tried again until they change.
+        if (frame.targets != targets) {
+            _Release(frame);
+            frame.targets = targets;
+            _Allocate(frame, framebuffer);
+        }
+        if (frame.framebuffer == 0) { return; }
+        _Blit(frame, framebuffer, frame.framebuffer);
+        frame.fingerprint = fingerprint;
+        frame.valid = true;
+    }
+
+    /// Releases the copies, requires the GL context VP2 renders with.
+    void Clear() {
+        for (auto& it : _frames) { _Release(it.second); }
+        _frames.clear();
+    }
+
+private:
+    struct Frame {
+        Targets targets;
+        size_t fingerprint = 0;
+        GLuint framebuffer = 0;
+        GLuint colorBuffer = 0;
+        GLuint depthBuffer = 0;
+        bool valid = false;
+    };
+
+    static GLenum _GetColorFormat(GLint componentType, GLint size) {
+        if (componentType == GL_FLOAT) {
+            if (size == 32) { return GL_RGBA32F; }
+            if (size == 16) { return GL_RGBA16F; }
+        } else if (componentType == GL_UNSIGNED_NORMALIZED && size == 8) {
+            return GL_RGBA8;
+        }
+        return GL_NONE;
+    }
+
+    static GLenum _GetDepthFormat(
+        GLint componentType, GLint size, GLint stencilSize) {
+        if (componentType == GL_FLOAT && size == 32) {
+            return stencilSize > 0 ? GL_DEPTH32F_STENCIL8
+                                   : GL_DEPTH_COMPONENT32F;
+        }
+        if (size == 24) {
+            return stencilSize > 0 ? GL_DEPTH24_STENCIL8
+                                   : GL_DEPTH_COMPONENT24;
+        }
+        if (size == 16 && stencilSize == 0) { return GL_DEPTH_COMPONENT16; }
+        return GL_NONE;
+    }
+
+    static GLuint _CreateRenderbuffer(
+        GLenum format, GLint samples, const Targets& targets) {
+        GLuint renderbuffer = 0;
+        glGenRenderbuffers(1, &renderbuffer);
+        glBindRenderbuffer(GL_RENDERBUFFER, renderbuffer);
+        if (samples > 0) {
+            glRenderbufferStorageMultisample(
+                GL_RENDERBUFFER, samples, format, targets.width,
+                targets.height);
+        } else {
+            glRenderbufferStorage(
+                GL_RENDERBUFFER, format, targets.width, targets.height);
+        }
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+        return renderbuffer;
+    }
+
+    /// Allocates the copies with the formats and sample count of the bound
+    /// framebuffer, so multisampled targets are blitted without resolving
+    /// them. The formats are only queried when the targets change.
+    static void _Allocate(Frame& frame, GLint framebuffer) {
+        auto getParameter = [](GLenum attachment, GLenum name) -> GLint {
+            GLint value = 0;
+            glGetFramebufferAttachmentParameteriv(
+                GL_DRAW_FRAMEBUFFER, attachment, name, &value);
+            return value;
+        };
+        if (getParameter(
+                GL_COLOR_ATTACHMENT0, GL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE) ==
+                GL_NONE ||
+            getParameter(
+                GL_DEPTH_ATTACHMENT, GL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE) ==
+                GL_NONE) {
+            return;
+        }
+        const auto colorFormat = _GetColorFormat(
+            getParameter(
+                GL_COLOR_ATTACHMENT0, GL_FRAMEBUFFER_ATTACHMENT_COMPONENT_TYPE),
+            getParameter(
+                GL_COLOR_ATTACHMENT0, GL_FRAMEBUFFER_ATTACHMENT_RED_SIZE));
+        const auto stencilSize =
+            getParameter(
+                GL_STENCIL_ATTACHMENT, GL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE) ==
+                    GL_NONE
+                ? 0
+                : getParameter(
+                      GL_STENCIL_ATTACHMENT,
+                      GL_FRAMEBUFFER_ATTACHMENT_STENCIL_SIZE);
+        const auto depthFormat = _GetDepthFormat(
+            getParameter(
+                GL_DEPTH_ATTACHMENT, GL_FRAMEBUFFER_ATTACHMENT_COMPONENT_TYPE),
+            getParameter(
+                GL_DEPTH_ATTACHMENT, GL_FRAMEBUFFER_ATTACHMENT_DEPTH_SIZE),
+            stencilSize);
+        if (colorFormat == GL_NONE || depthFormat == GL_NONE) { return; }
+        GLint samples = 0;
+        glGetIntegerv(GL_SAMPLES, &samples);
+
+        frame.colorBuffer =
+            _CreateRenderbuffer(colorFormat, samples, frame.targets);
+        frame.depthBuffer =
+            _CreateRenderbuffer(depthFormat, samples, frame.targets);
+        glGenFramebuffers(1, &frame.framebuffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, frame.framebuffer);
+        glFramebufferRenderbuffer(
+            GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER,
+            frame.colorBuffer);
+        glFramebufferRenderbuffer(
+            GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER,
+            frame.depthBuffer);
+        const auto status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+        // Drivers are free to round up the sample count of renderbuffers.
+        GLint copySamples = 0;
+        glGetIntegerv(GL_SAMPLES, &copySamples);
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        if (status != GL_FRAMEBUFFER_COMPLETE || copySamples != samples) {
+            _Release(frame);
+        }
+    }
+
+    static void _Release(Frame& frame) {
+        if (frame.framebuffer != 0) {
+            glDeleteFramebuffers(1, &frame.framebuffer);
+            frame.framebuffer = 0;
+        }
+        if (frame.colorBuffer != 0) {
+            glDeleteRenderbuffers(1, &frame.colorBuffer);
+            frame.colorBuffer = 0;
+        }
+        if (frame.depthBuffer != 0) {
+            glDeleteRenderbuffers(1, &frame.depthBuffer);
+            frame.depthBuffer = 0;
+        }
+        frame.valid = false;
+    }
+
+    /// Blits from one framebuffer to the other, and binds the framebuffer VP2
+    /// renders to again.
+    static void _Blit(const Frame& frame, GLint from, GLint to) {
+        // VP2 may bind different read and draw framebuffers.
+        GLint readFramebuffer = 0;
+        GLint drawFramebuffer = 0;
+        glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &readFramebuffer);
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &drawFramebuffer);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, from);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, to);
+        glBlitFramebuffer(
+            0, 0, frame.targets.width, frame.targets.height, 0, 0,
+            frame.targets.width, frame.targets.height,
+            GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, readFramebuffer);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, drawFramebuffer);
+    }
+
+    std::unordered_map<std::string, Frame> _frames;
 };
 
 PXR_NAMESPACE_CLOSE_SCOPE
@@ -23,10 +23,13 @@
 //
 #include "viewCommand.h"
 
+#include <pxr/base/tf/stringUtils.h>
+
 #include <maya/MArgDatabase.h>
 #include <maya/MGlobal.h>
 #include <maya/MSyntax.h>
 
+#include <hdmaya/adapters/adapterRegistry.h>
 #include <hdmaya/delegates/delegateRegistry.h>
 #include "plugin/renderOverride.h"
 
@@ -58,6 +61,33 @@ constexpr auto _createRenderGlobalsLong = "-createRenderGlobals";
 constexpr auto _updateRenderGlobals = "-urg";
 constexpr auto _updateRenderGlobalsLong = "-updateRenderGlobals";
 
+constexpr auto _refreshRenderSettings = "-rrs";
+constexpr auto _refreshRenderSettingsLong = "-refreshRenderSettings";
+
+constexpr auto _refreshTextures = "-rt";
+constexpr auto _refreshTexturesLong = "-refreshTextures";
+
+constexpr auto _textureMemory = "-tm";
+constexpr auto _textureMemoryLong = "-textureMemory";
+
+constexpr auto _shadowCasters = "-sc";
+constexpr auto _shadowCastersLong = "-shadowCasters";
+
+constexpr auto _shadowMapRenders = "-smr";
+constexpr auto _shadowMapRendersLong = "-shadowMapRenders";
+
+constexpr auto _refreshStats = "-rs";
+constexpr auto _refreshStatsLong = "-refreshStats";
+
+constexpr auto _pipelineStats = "-ps";
+constexpr auto _pipelineStatsLong = "-pipelineStats";
+
+constexpr auto _callbackStats = "-cs";
+constexpr auto _callbackStatsLong = "-callbackStats";
+
+constexpr auto _adapterPlugins = "-ap";
+constexpr auto _adapterPluginsLong = "-adapterPlugins";
+
 constexpr auto _help = "-h";
 constexpr auto _helpLong = "-help";
 
@@ -67,6 +97,9 @@ constexpr auto _verboseLong = "-verbose";
 constexpr auto _listRenderIndex = "-lri";
 constexpr auto _listRenderIndexLong = "-listRenderIndex";
 
+constexpr auto _listSelection = "-lsl";
+constexpr auto _listSelectionLong = "-listSelection";
+
 constexpr auto _visibleOnly = "-vo";
 constexpr auto _visibleOnlyLong = "-visibleOnly";
 
@@ -86,6 +119,12 @@ Usage: mtoh [flags]
 -createRenderGlobals/-crg : Creates the render globals.
 -updateRenderGlobals/-urg : Forces the update of the render globals for the
     viewport.
+-refreshRenderSettings/-rrs : Reads the render settings of all render
+    delegates again, instead of the ones cached when they were last read.
+-refreshTextures/-rt : Resolves the texture file paths and UDIM tiles again,
+    after textures were added to or removed from disk.
+-textureMemory/-tm [RENDERER]: Returns the texture memory usage and budget of
+    each scene delegate for the given render delegate.
 )HELP";
 
 constexpr auto _helpNonVerboseText = R"HELP(
@@ -102,9 +141,37 @@ Debug flags:
 -visibleOnly/-vo: Flag which affects the behavior of -listRenderIndex - if
     given, then only visible items in the render index are returned.
 
+-listSelection/-lsl [RENDERER]: Returns the rprims of the selection
+    collection for the given render delegate, prefixed with "collection: ",
+    followed by the rprims highlighted as selected, prefixed with
+    "highlighted: ".
+
 -sceneDelegateId/-sid [RENDERER] [SCENE_DELEGATE]: Returns the path id
     corresponding to the given render delegate / scene delegate pair.
 
+-shadowCasters/-sc [RENDERER]: Returns the number of shapes rendered into the
+    shadow map of each shadowed light for the given render delegate.
+
+-shadowMapRenders/-smr [RENDERER]: Returns the number of frames the shadow
+    maps were rendered in for the given render delegate. Frames reusing the
+    shadow maps of an earlier frame are not counted.
+
+-refreshStats/-rs [RENDERER]: Returns the state of the refresh scheduler,
+    which refreshes the viewport until the given render delegate converged.
+
+-pipelineStats/-ps [RENDERER]: Returns the state of pipelined playback for
+    the given render delegate: whether it is active, the number of frames
+    the rendered scene lags behind Maya, the number of prims drawn from
+    staged data and the playback frame rate.
+
+-callbackStats/-cs [RENDERER]: Returns whether the given render delegate is
+    used by any panel, the number of Maya callbacks it registered and how
+    many times they were invoked. Unused render delegates register none.
+
+-adapterPlugins/-ap : Returns the adapter plugins loaded and the time it took
+    to load each of them, followed by the plugins that are loaded once the
+    scene contains a node they handle.
+
 )HELP";
 
 } // namespace
@@ -125,6 +192,24 @@ MSyntax MtohViewCmd::createSyntax() {
 
     syntax.addFlag(_updateRenderGlobals, _updateRenderGlobalsLong);
 
+    syntax.addFlag(_refreshRenderSettings, _refreshRenderSettingsLong);
+
+    syntax.addFlag(_refreshTextures, _refreshTexturesLong);
+
+    syntax.addFlag(_textureMemory, _textureMemoryLong, MSyntax::kString);
+
+    syntax.addFlag(_shadowCasters, _shadowCastersLong, MSyntax::kString);
+
+    syntax.addFlag(_shadowMapRenders, _shadowMapRendersLong, MSyntax::kString);
+
+    syntax.addFlag(_refreshStats, _refreshStatsLong, MSyntax::kString);
+
+    syntax.addFlag(_pipelineStats, _pipelineStatsLong, MSyntax::kString);
+
+    syntax.addFlag(_callbackStats, _callbackStatsLong, MSyntax::kString);
+
+    syntax.addFlag(_adapterPlugins, _adapterPluginsLong);
+
     syntax.addFlag(_help, _helpLong);
 
     syntax.addFlag(_verbose, _verboseLong);
@@ -135,6 +220,8 @@ MSyntax MtohViewCmd::createSyntax() {
 
     syntax.addFlag(_visibleOnly, _visibleOnlyLong);
 
+    syntax.addFlag(_listSelection, _listSelectionLong, MSyntax::kString);
+
     syntax.addFlag(
         _sceneDelegateId, _sceneDelegateIdLong, MSyntax::kString,
         MSyntax::kString);
@@ -186,6 +273,80 @@ MStatus MtohViewCmd::doIt(const MArgList& args) {
         MtohCreateRenderGlobals();
     } else if (db.isFlagSet(_updateRenderGlobals)) {
         MtohRenderOverride::UpdateRenderGlobals();
+    } else if (db.isFlagSet(_adapterPlugins)) {
+        for (const auto& plugin : HdMayaAdapterRegistry::GetLoadedPlugins()) {
+            appendToResult(TfStringPrintf(
+                               "%s: loaded in %.1f ms", plugin.first.c_str(),
+                               plugin.second)
+                               .c_str());
+        }
+        for (const auto& plugin : HdMayaAdapterRegistry::GetDeferredPlugins()) {
+            appendToResult(
+                TfStringPrintf("%s: deferred", plugin.c_str()).c_str());
+        }
+        // Want to return an empty list, not None
+        if (!isCurrentResultArray()) { setResult(MStringArray()); }
+    } else if (db.isFlagSet(_refreshRenderSettings)) {
+        MtohInitializeRenderGlobals(true);
+        MtohCreateRenderGlobals();
+        MtohRenderOverride::UpdateRenderGlobals();
+    } else if (db.isFlagSet(_refreshTextures)) {
+        MtohRenderOverride::RefreshFileTextures();
+    } else if (db.isFlagSet(_textureMemory)) {
+        MString id;
+        CHECK_MSTATUS_AND_RETURN_IT(db.getFlagArgument(_textureMemory, 0, id));
+        for (const auto& usage :
+             MtohRenderOverride::RendererTextureMemoryUsage(
+                 TfToken(id.asChar()))) {
+            appendToResult(usage.c_str());
+        }
+        // Want to return an empty list, not None
+        if (!isCurrentResultArray()) { setResult(MStringArray()); }
+    } else if (db.isFlagSet(_shadowCasters)) {
+        MString id;
+        CHECK_MSTATUS_AND_RETURN_IT(db.getFlagArgument(_shadowCasters, 0, id));
+        for (const auto& count :
+             MtohRenderOverride::RendererShadowCasterCounts(
+                 TfToken(id.asChar()))) {
+            appendToResult(count.c_str());
+        }
+        // Want to return an empty list, not None
+        if (!isCurrentResultArray()) { setResult(MStringArray()); }
+    } else if (db.isFlagSet(_shadowMapRenders)) {
+        MString id;
+        CHECK_MSTATUS_AND_RETURN_IT(
+            db.getFlagArgument(_shadowMapRenders, 0, id));
+        setResult(MtohRenderOverride::RendererShadowMapRenders(
+            TfToken(id.asChar())));
+    } else if (db.isFlagSet(_refreshStats)) {
+        MString id;
+        CHECK_MSTATUS_AND_RETURN_IT(db.getFlagArgument(_refreshStats, 0, id));
+        for (const auto& stat : MtohRenderOverride::RendererRefreshStats(
+                 TfToken(id.asChar()))) {
+            appendToResult(stat.c_str());
+        }
+        // Want to return an empty list, not None
+        if (!isCurrentResultArray()) { setResult(MStringArray()); }
+    } else if (db.isFlagSet(_pipelineStats)) {
+        MString id;
+        CHECK_MSTATUS_AND_RETURN_IT(
+            db.getFlagArgument(_pipelineStats, 0, id));
+        for (const auto& stat : MtohRenderOverride::RendererPipelineStats(
+                 TfToken(id.asChar()))) {
+            appendToResult(stat.c_str());
+        }
+        // Want to return an empty list, not None
+        if (!isCurrentResultArray()) { setResult(MStringArray()); }
+    } else if (db.isFlagSet(_callbackStats)) {
+        MString id;
+        CHECK_MSTATUS_AND_RETURN_IT(
+            db.getFlagArgument(_callbackStats, 0, id));
+        for (const auto& stat : MtohRenderOverride::RendererCallbackStats(
+                 TfToken(id.asChar()))) {
+            appendToResult(stat.c_str());
+        }
+        // Want to return an empty list, not None
+        if (!isCurrentResultArray()) { setResult(MStringArray()); }
     } else if (db.isFlagSet(_listRenderIndex)) {
         MString id;
         CHECK_MSTATUS_AND_RETURN_IT(
@@ -198,6 +359,15 @@ MStatus MtohViewCmd::doIt(const MArgList& args) {
         }
         // Want to return an empty list, not None
         if (!isCurrentResultArray()) { setResult(MStringArray()); }
+    } else if (db.isFlagSet(_listSelection)) {
+        MString id;
+        CHECK_MSTATUS_AND_RETURN_IT(db.getFlagArgument(_listSelection, 0, id));
+        for (const auto& item :
+             MtohRenderOverride::RendererSelection(TfToken(id.asChar()))) {
+            appendToResult(item.c_str());
+        }
+        // Want to return an empty list, not None
+        if (!isCurrentResultArray()) { setResult(MStringArray()); }
     } else if (db.isFlagSet(_sceneDelegateId)) {
         MString renderDelegateName;
         MString sceneDelegateName;
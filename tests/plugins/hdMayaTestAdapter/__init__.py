@@ -0,0 +1,2 @@
+# Adapter plugin fixture for test_mtoh_command. It only declares the node
+# types it handles, so the tests can check when hdmaya loads it.
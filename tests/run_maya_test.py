@@ -73,6 +73,16 @@ def get_environ(test_script, tempdir):
     env['MAYA_APP_DIR'] = os.path.join(tempdir, "maya_app_dir")
     env['HDMAYA_TEST_TEMPDIR'] = tempdir
     env['HDMAYA_TEST_SCRIPT'] = test_script
+    env['HDMAYA_TEXTURE_CACHE_DIRECTORY'] = os.path.join(
+        tempdir, "texture_cache")
+
+    # Adapter plugins used by the tests, which are loaded on demand
+    plugins_dir = os.path.join(THIS_DIR, "plugins")
+    for key, path in (
+            ('PXR_PLUGINPATH_NAME',
+             os.path.join(plugins_dir, "hdMayaTestAdapter", "")),
+            ('PYTHONPATH', plugins_dir)):
+        env[key] = os.pathsep.join(filter(None, [path, env.get(key)]))
 
     TEST_ENV_PREFIX = "HDMAYA_TEST_ENV_"
     # cmake / ctest may be invoked in a "build" environment which
@@ -1,6 +1,11 @@
 import maya.cmds as cmds
 import maya.mel as mel
+import maya.OpenMaya as om
 
+import os
+import shutil
+import tempfile
+import time
 import unittest
 
 import hdmaya_test_utils
@@ -77,6 +82,645 @@ class TestCommand(unittest.TestCase):
             self.assertFalse(cmds.getAttr(
                 "defaultRenderGlobals.mtohEnableMotionSamples"))
 
+    def test_textureMemory(self):
+        self.assertEqual(
+            cmds.mtoh(textureMemory=hdmaya_test_utils.HD_STORM), [])
+
+        cmds.file(f=1, new=1)
+        activeEditor = cmds.playblast(ae=1)
+        cmds.modelEditor(
+            activeEditor, e=1,
+            rendererOverrideName=hdmaya_test_utils.HD_STORM_OVERRIDE)
+        cmds.refresh(f=1)
+
+        usage = cmds.mtoh(textureMemory=hdmaya_test_utils.HD_STORM)
+        self.assertEqual(usage, cmds.mtoh(tm=hdmaya_test_utils.HD_STORM))
+        self.assertEqual(len(usage), 1)
+        self.assertTrue(usage[0].startswith("HdMayaSceneDelegate: "))
+        self.assertIn("unlimited budget", usage[0])
+
+        cmds.mtoh(createRenderGlobals=1)
+        cmds.setAttr("defaultRenderGlobals.mtohTextureMemoryBudget", 512)
+        cmds.mtoh(updateRenderGlobals=1)
+        cmds.refresh(f=1)
+
+        usage = cmds.mtoh(textureMemory=hdmaya_test_utils.HD_STORM)
+        self.assertIn("512.0 MB budget", usage[0])
+
+        cmds.modelEditor(activeEditor, rendererOverrideName="", e=1)
+        cmds.refresh(f=1)
+
+    def test_refreshTextures(self):
+        cmds.file(f=1, new=1)
+        textureDir = tempfile.mkdtemp()
+        self.addCleanup(shutil.rmtree, textureDir)
+
+        def writeTile(tile):
+            image = om.MImage()
+            image.create(512, 512)
+            image.writeToFile(
+                os.path.join(textureDir, "tiles.%i.png" % tile), "png")
+
+        writeTile(1001)
+        plane = cmds.polyPlane()[0]
+        shader = cmds.shadingNode("lambert", asShader=1)
+        shadingEngine = cmds.sets(
+            renderable=1, noSurfaceShader=1, empty=1)
+        cmds.connectAttr(
+            shader + ".outColor", shadingEngine + ".surfaceShader")
+        cmds.sets(plane, e=1, forceElement=shadingEngine)
+        fileNode = cmds.shadingNode("file", asTexture=1)
+        cmds.setAttr(fileNode + ".uvTilingMode", 3)
+        cmds.setAttr(
+            fileNode + ".fileTextureName",
+            os.path.join(textureDir, "tiles.1001.png"), type="string")
+        cmds.connectAttr(fileNode + ".outColor", shader + ".color")
+
+        activeEditor = cmds.playblast(ae=1)
+        cmds.modelEditor(
+            activeEditor, e=1,
+            rendererOverrideName=hdmaya_test_utils.HD_STORM_OVERRIDE)
+        cmds.refresh(f=1)
+
+        def memoryUsed():
+            usage = cmds.mtoh(textureMemory=hdmaya_test_utils.HD_STORM)
+            return float(usage[0].split(", ")[1].split(" MB")[0])
+
+        oneTileMemory = memoryUsed()
+        self.assertGreater(oneTileMemory, 0.0)
+
+        # The new tile is another layer of the UDIM texture.
+        writeTile(1002)
+        cmds.mtoh(refreshTextures=1)
+        cmds.refresh(f=1)
+        self.assertGreater(memoryUsed(), oneTileMemory)
+
+        cmds.modelEditor(activeEditor, rendererOverrideName="", e=1)
+        cmds.refresh(f=1)
+
+    def test_textureCache(self):
+        cacheDir = os.environ.get("HDMAYA_TEXTURE_CACHE_DIRECTORY")
+        if not cacheDir:
+            self.skipTest("HDMAYA_TEXTURE_CACHE_DIRECTORY is not set")
+
+        cmds.file(f=1, new=1)
+        textureDir = tempfile.mkdtemp()
+        self.addCleanup(shutil.rmtree, textureDir)
+
+        def cacheEntries():
+            if not os.path.isdir(cacheDir):
+                return []
+            return sorted(
+                entry for entry in os.listdir(cacheDir)
+                if entry.endswith(".tga") and not entry.endswith(".tmp.tga"))
+
+        def addTexturedPlane(fileName, imageFormat):
+            texturePath = os.path.join(textureDir, fileName)
+            image = om.MImage()
+            image.create(512, 512)
+            image.writeToFile(texturePath, imageFormat)
+            plane = cmds.polyPlane()[0]
+            shader = cmds.shadingNode("lambert", asShader=1)
+            shadingEngine = cmds.sets(
+                renderable=1, noSurfaceShader=1, empty=1)
+            cmds.connectAttr(
+                shader + ".outColor", shadingEngine + ".surfaceShader")
+            cmds.sets(plane, e=1, forceElement=shadingEngine)
+            fileNode = cmds.shadingNode("file", asTexture=1)
+            cmds.setAttr(
+                fileNode + ".fileTextureName", texturePath, type="string")
+            cmds.connectAttr(fileNode + ".outColor", shader + ".color")
+
+        # Textures are decoded in the background, so the entries are stored
+        # some time after the first draw.
+        def refreshUntilConverged():
+            for _ in range(100):
+                cmds.refresh(f=1)
+                stats = cmds.mtoh(refreshStats=hdmaya_test_utils.HD_STORM)
+                if stats[0] == "converged: true":
+                    return
+                time.sleep(0.1)
+            self.fail("Textures were not loaded")
+
+        entries = cacheEntries()
+        addTexturedPlane("cached.png", "png")
+        # Uncompressed formats are not worth caching.
+        addTexturedPlane("uncached.tga", "tga")
+        activeEditor = cmds.playblast(ae=1)
+        cmds.modelEditor(
+            activeEditor, e=1,
+            rendererOverrideName=hdmaya_test_utils.HD_STORM_OVERRIDE)
+        refreshUntilConverged()
+
+        newEntries = [
+            entry for entry in cacheEntries() if entry not in entries]
+        self.assertEqual(len(newEntries), 1)
+        # The decoded pixels are stored uncompressed.
+        self.assertGreaterEqual(
+            os.path.getsize(os.path.join(cacheDir, newEntries[0])),
+            512 * 512 * 3)
+        self.assertEqual(
+            [entry for entry in os.listdir(cacheDir)
+             if entry.endswith(".tmp.tga")], [])
+
+        # Entries are keyed by the source path.
+        entries = cacheEntries()
+        addTexturedPlane("copy.png", "png")
+        refreshUntilConverged()
+        self.assertEqual(len(cacheEntries()), len(entries) + 1)
+
+        cmds.modelEditor(activeEditor, rendererOverrideName="", e=1)
+        cmds.refresh(f=1)
+
+    def test_shadowCasters(self):
+        self.assertEqual(
+            cmds.mtoh(shadowCasters=hdmaya_test_utils.HD_STORM), [])
+
+        cmds.file(f=1, new=1)
+        light = cmds.spotLight(coneAngle=40)
+        cmds.setAttr(light + ".useDepthMapShadows", 1)
+        lit = cmds.polyCube()[0]
+        cmds.setAttr(lit + ".translateZ", -5)
+        unlit = cmds.polyCube()[0]
+        cmds.setAttr(unlit + ".translateZ", 5)
+        activeEditor = cmds.playblast(ae=1)
+        cmds.modelEditor(
+            activeEditor, e=1,
+            rendererOverrideName=hdmaya_test_utils.HD_STORM_OVERRIDE)
+        cmds.refresh(f=1)
+
+        counts = cmds.mtoh(shadowCasters=hdmaya_test_utils.HD_STORM)
+        self.assertEqual(counts, cmds.mtoh(sc=hdmaya_test_utils.HD_STORM))
+        self.assertEqual(len(counts), 1)
+        self.assertTrue(counts[0].endswith(": 1 shadow casters"))
+
+        cmds.setAttr(unlit + ".translateZ", -10)
+        cmds.refresh(f=1)
+        counts = cmds.mtoh(shadowCasters=hdmaya_test_utils.HD_STORM)
+        self.assertTrue(counts[0].endswith(": 2 shadow casters"))
+
+        cmds.setAttr(lit + ".castsShadows", 0)
+        cmds.refresh(f=1)
+        counts = cmds.mtoh(shadowCasters=hdmaya_test_utils.HD_STORM)
+        self.assertTrue(counts[0].endswith(": 1 shadow casters"))
+
+        cmds.modelEditor(activeEditor, rendererOverrideName="", e=1)
+        cmds.refresh(f=1)
+
+    def test_lightSetMembership(self):
+        cmds.file(f=1, new=1)
+        lights = []
+        for i in range(2):
+            light = cmds.spotLight(coneAngle=40)
+            cmds.setAttr(light + ".useDepthMapShadows", 1)
+            lights.append(light)
+        transform = cmds.listRelatives(lights[0], parent=1)[0]
+        cube = cmds.polyCube()[0]
+        cmds.setAttr(cube + ".translateZ", -5)
+        activeEditor = cmds.playblast(ae=1)
+        cmds.modelEditor(
+            activeEditor, e=1,
+            rendererOverrideName=hdmaya_test_utils.HD_STORM_OVERRIDE)
+        cmds.refresh(f=1)
+
+        # Only the lights inserted into the render index are listed.
+        def assertLightsInserted(*lights):
+            cmds.refresh(f=1)
+            counts = cmds.mtoh(shadowCasters=hdmaya_test_utils.HD_STORM)
+            self.assertEqual(len(counts), len(lights))
+            for light in lights:
+                self.assertEqual(
+                    len([count for count in counts if light in count]), 1)
+
+        assertLightsInserted(*lights)
+        cmds.sets(transform, remove="defaultLightSet")
+        assertLightsInserted(lights[1])
+        # Other sets don't light anything.
+        otherSet = cmds.sets(empty=1)
+        cmds.sets(transform, add=otherSet)
+        assertLightsInserted(lights[1])
+        cmds.sets(transform, add="defaultLightSet")
+        assertLightsInserted(*lights)
+        cmds.delete(otherSet)
+        assertLightsInserted(*lights)
+
+        cmds.modelEditor(activeEditor, rendererOverrideName="", e=1)
+        cmds.refresh(f=1)
+
+    def test_maximumLights(self):
+        cmds.file(f=1, new=1)
+        lights = []
+        for intensity in (1, 2, 3, 4):
+            light = cmds.spotLight(coneAngle=40, intensity=intensity)
+            cmds.setAttr(light + ".useDepthMapShadows", 1)
+            lights.append(light)
+        cube = cmds.polyCube()[0]
+        cmds.setAttr(cube + ".translateZ", -5)
+        activeEditor = cmds.playblast(ae=1)
+        cmds.modelEditor(
+            activeEditor, e=1,
+            rendererOverrideName=hdmaya_test_utils.HD_STORM_OVERRIDE)
+        cmds.mtoh(createRenderGlobals=1)
+        cmds.setAttr("defaultRenderGlobals.mtohMaximumLights", 2)
+        cmds.mtoh(updateRenderGlobals=1)
+
+        # Picked and dropped lights fade in and out over a few frames, and
+        # dropped lights are removed from the render index once faded out.
+        def assertLightsPicked(*lights):
+            for _ in range(20):
+                cmds.refresh(f=1)
+                stats = cmds.mtoh(refreshStats=hdmaya_test_utils.HD_STORM)
+                if stats[0] == "converged: true":
+                    break
+            counts = cmds.mtoh(shadowCasters=hdmaya_test_utils.HD_STORM)
+            self.assertEqual(len(counts), len(lights))
+            for light in lights:
+                self.assertEqual(
+                    len([count for count in counts if light in count]), 1)
+
+        assertLightsPicked(lights[2], lights[3])
+        cmds.setAttr(lights[0] + ".intensity", 10)
+        assertLightsPicked(lights[0], lights[3])
+        # Picked lights are only dropped for clearly more important lights.
+        cmds.setAttr(lights[1] + ".intensity", 4.5)
+        assertLightsPicked(lights[0], lights[3])
+
+        cmds.setAttr("defaultRenderGlobals.mtohLightImportanceThreshold", 5)
+        cmds.mtoh(updateRenderGlobals=1)
+        assertLightsPicked(lights[0])
+
+        cmds.setAttr("defaultRenderGlobals.mtohLightImportanceThreshold", 0)
+        cmds.setAttr("defaultRenderGlobals.mtohMaximumLights", 0)
+        cmds.mtoh(updateRenderGlobals=1)
+        assertLightsPicked(*lights)
+
+        cmds.modelEditor(activeEditor, rendererOverrideName="", e=1)
+        cmds.refresh(f=1)
+
+    def test_shadowMapRenders(self):
+        self.assertEqual(
+            cmds.mtoh(shadowMapRenders=hdmaya_test_utils.HD_STORM), 0)
+
+        cmds.file(f=1, new=1)
+        light = cmds.spotLight(coneAngle=40)
+        cmds.setAttr(light + ".useDepthMapShadows", 1)
+        cube = cmds.polyCube()[0]
+        cmds.setAttr(cube + ".translateZ", -5)
+        activeEditor = cmds.playblast(ae=1)
+        cmds.modelEditor(
+            activeEditor, e=1,
+            rendererOverrideName=hdmaya_test_utils.HD_STORM_OVERRIDE)
+        cmds.refresh(f=1)
+        cmds.refresh(f=1)
+
+        renders = cmds.mtoh(shadowMapRenders=hdmaya_test_utils.HD_STORM)
+        self.assertGreater(renders, 0)
+        self.assertEqual(
+            renders, cmds.mtoh(smr=hdmaya_test_utils.HD_STORM))
+
+        # Moving only the camera reuses the shadow maps.
+        camera = cmds.modelEditor(activeEditor, q=1, camera=1)
+        cmds.setAttr(camera + ".rotateY", 10)
+        cmds.refresh(f=1)
+        self.assertEqual(
+            cmds.mtoh(shadowMapRenders=hdmaya_test_utils.HD_STORM), renders)
+
+        cmds.setAttr(cube + ".translateX", 1)
+        cmds.refresh(f=1)
+        self.assertEqual(
+            cmds.mtoh(shadowMapRenders=hdmaya_test_utils.HD_STORM),
+            renders + 1)
+
+        cmds.setAttr(light + ".intensity", 2)
+        cmds.refresh(f=1)
+        self.assertEqual(
+            cmds.mtoh(shadowMapRenders=hdmaya_test_utils.HD_STORM),
+            renders + 2)
+
+        cmds.modelEditor(activeEditor, rendererOverrideName="", e=1)
+        cmds.refresh(f=1)
+
+    def test_listSelection(self):
+        cmds.file(f=1, new=1)
+        cube1 = cmds.polyCube()[0]
+        cube2 = cmds.polyCube()[0]
+        group = cmds.group(cube1, cube2)
+        cube3 = cmds.polyCube()[0]
+        activeEditor = cmds.playblast(ae=1)
+        cmds.modelEditor(
+            activeEditor, e=1,
+            rendererOverrideName=hdmaya_test_utils.HD_STORM_OVERRIDE)
+        cmds.select(clear=1)
+        cmds.refresh(f=1)
+        delegateId = cmds.mtoh(sceneDelegateId=(
+            hdmaya_test_utils.HD_STORM, "HdMayaSceneDelegate"))
+
+        def rprims(*transforms):
+            shapes = [
+                cmds.listRelatives(transform, shapes=1, fullPath=1)[0]
+                for transform in transforms]
+            return sorted(
+                "/".join([delegateId, "rprims",
+                          shape.lstrip("|").replace("|", "/")])
+                for shape in shapes)
+
+        def assertSelected(*transforms):
+            cmds.refresh(f=1)
+            expected = rprims(*transforms)
+            self.assertEqual(
+                cmds.mtoh(listSelection=hdmaya_test_utils.HD_STORM),
+                ["collection: " + rprim for rprim in expected] +
+                ["highlighted: " + rprim for rprim in expected])
+
+        assertSelected()
+        cmds.select(group + "|" + cube1)
+        assertSelected(group + "|" + cube1)
+        cmds.select(cube3, add=1)
+        assertSelected(group + "|" + cube1, cube3)
+        # The shapes below a selected group are selected once.
+        cmds.select(group, add=1)
+        assertSelected(group + "|" + cube1, group + "|" + cube2, cube3)
+        cmds.select(cube3, deselect=1)
+        assertSelected(group + "|" + cube1, group + "|" + cube2)
+        cmds.select(group, deselect=1)
+        assertSelected(group + "|" + cube1)
+        # Selected shapes added to the scene are found.
+        cube4 = cmds.polyCube()[0]
+        cmds.parent(cube4, group)
+        cmds.select(group)
+        assertSelected(
+            group + "|" + cube1, group + "|" + cube2, group + "|" + cube4)
+        cmds.select(clear=1)
+        assertSelected()
+
+        cmds.modelEditor(activeEditor, rendererOverrideName="", e=1)
+        cmds.refresh(f=1)
+
+    def test_refreshStats(self):
+        self.assertEqual(
+            cmds.mtoh(refreshStats=hdmaya_test_utils.HD_STORM), [])
+
+        cmds.file(f=1, new=1)
+        cmds.polyCube()
+        activeEditor = cmds.playblast(ae=1)
+        cmds.modelEditor(
+            activeEditor, e=1,
+            rendererOverrideName=hdmaya_test_utils.HD_STORM_OVERRIDE)
+        cmds.refresh(f=1)
+
+        stats = cmds.mtoh(refreshStats=hdmaya_test_utils.HD_STORM)
+        self.assertEqual(len(stats), 8)
+        self.assertEqual(stats[0], "converged: true")
+        self.assertEqual(stats[1], "refresh interval: stopped")
+        self.assertTrue(stats[2].startswith("render time: "))
+        self.assertTrue(stats[3].startswith("refreshes: "))
+        self.assertTrue(stats[4].startswith("scene updates: "))
+        self.assertEqual(stats[5], "reused frames: 0")
+        self.assertEqual(stats[6], "resolution scale: 1.00")
+        self.assertTrue(stats[7].startswith("render threads: "))
+
+        cmds.modelEditor(activeEditor, rendererOverrideName="", e=1)
+        cmds.refresh(f=1)
+
+    def test_pipelineStats(self):
+        self.assertEqual(
+            cmds.mtoh(pipelineStats=hdmaya_test_utils.HD_STORM), [])
+
+        cmds.file(f=1, new=1)
+        cmds.polyCube()
+        activeEditor = cmds.playblast(ae=1)
+        cmds.modelEditor(
+            activeEditor, e=1,
+            rendererOverrideName=hdmaya_test_utils.HD_STORM_OVERRIDE)
+        cmds.mtoh(createRenderGlobals=1)
+        cmds.setAttr("defaultRenderGlobals.mtohPipelinedPlayback", 1)
+        cmds.mtoh(updateRenderGlobals=1)
+        cmds.refresh(f=1)
+
+        # Interactive edits are not pipelined.
+        self.assertEqual(
+            cmds.mtoh(pipelineStats=hdmaya_test_utils.HD_STORM),
+            ["pipelined playback: off", "latency: 0 frames",
+             "staged prims: 0", "playback frame rate: 0.0 fps"])
+
+        cmds.setAttr("defaultRenderGlobals.mtohPipelinedPlayback", 0)
+        cmds.mtoh(updateRenderGlobals=1)
+        cmds.modelEditor(activeEditor, rendererOverrideName="", e=1)
+        cmds.refresh(f=1)
+
+    def test_pipelinedPlayback(self):
+        cmds.file(f=1, new=1)
+        # A deformed mesh, a moved mesh and a deformed curve, which doesn't
+        # expose its raw points.
+        bent = cmds.polyCube(sy=10)[0]
+        bend = cmds.nonLinear(bent, type="bend")[0]
+        cmds.setKeyframe(bend, attribute="curvature", t=1, v=0)
+        cmds.setKeyframe(bend, attribute="curvature", t=10, v=90)
+        moved = cmds.polyCube()[0]
+        cmds.setKeyframe(moved, attribute="translateX", t=1, v=0)
+        cmds.setKeyframe(moved, attribute="translateX", t=10, v=10)
+        curve = cmds.curve(p=[(0, 0, 0), (1, 1, 0), (2, 0, 0), (3, 1, 0)])
+        clusterHandle = cmds.cluster(curve + ".cv[3]")[1]
+        cmds.setKeyframe(clusterHandle, attribute="translateY", t=1, v=0)
+        cmds.setKeyframe(clusterHandle, attribute="translateY", t=10, v=5)
+        cmds.playbackOptions(min=1, max=10, loop="once")
+        cmds.currentTime(1)
+
+        activeEditor = cmds.playblast(ae=1)
+        cmds.modelEditor(
+            activeEditor, e=1,
+            rendererOverrideName=hdmaya_test_utils.HD_STORM_OVERRIDE)
+        cmds.mtoh(createRenderGlobals=1)
+        cmds.setAttr("defaultRenderGlobals.mtohPipelinedPlayback", 1)
+        cmds.mtoh(updateRenderGlobals=1)
+        cmds.refresh(f=1)
+
+        # The stats of the last drawn frame are read when Maya moves on to
+        # the next one.
+        stats = []
+        def timeChanged(time, clientData):
+            stats.append(
+                cmds.mtoh(pipelineStats=hdmaya_test_utils.HD_STORM))
+        callbackId = om.MDGMessage.addTimeChangeCallback(timeChanged)
+        try:
+            cmds.play(forward=True, wait=True)
+        finally:
+            om.MMessage.removeCallback(callbackId)
+
+        self.assertGreater(len(stats), 2)
+        # All three shapes change every frame, so Hydra draws all of them
+        # from the data staged during the last frame.
+        for frameStats in stats[2:]:
+            self.assertEqual(frameStats[0], "pipelined playback: on")
+            self.assertEqual(frameStats[1], "latency: 1 frames")
+            self.assertEqual(frameStats[2], "staged prims: 3")
+
+        # Once playback stopped, the shapes are read from Maya again.
+        cmds.refresh(f=1)
+        stats = cmds.mtoh(pipelineStats=hdmaya_test_utils.HD_STORM)
+        self.assertEqual(stats[0], "pipelined playback: off")
+        self.assertEqual(stats[1], "latency: 0 frames")
+        self.assertEqual(stats[2], "staged prims: 0")
+
+        cmds.setAttr("defaultRenderGlobals.mtohPipelinedPlayback", 0)
+        cmds.mtoh(updateRenderGlobals=1)
+        cmds.modelEditor(activeEditor, rendererOverrideName="", e=1)
+        cmds.refresh(f=1)
+
+    def test_sceneSwitch(self):
+        embree = "HdEmbreeRendererPlugin"
+        cmds.file(f=1, new=1)
+        for i in range(100):
+            cube = cmds.polyCube()[0]
+            cmds.setAttr(cube + ".translateX", i)
+        activeEditor = cmds.playblast(ae=1)
+        cmds.modelEditor(
+            activeEditor, e=1,
+            rendererOverrideName="mtohRenderOverride_" + embree)
+        cmds.refresh(f=1)
+        self.assertEqual(
+            len([rprim for rprim in cmds.mtoh(listRenderIndex=embree)
+                 if "/pCubeShape" in rprim]), 100)
+
+        def assertShapesInIndex(shape, removedShapes):
+            cmds.refresh(f=1)
+            self.assertEqual(cmds.mtoh(listActiveRenderers=1), [embree])
+            rprims = cmds.mtoh(listRenderIndex=embree)
+            self.assertEqual(
+                len([rprim for rprim in rprims
+                     if rprim.endswith("/" + shape)]), 1)
+            for removedShape in removedShapes:
+                self.assertFalse(any(
+                    "/" + removedShape in rprim for rprim in rprims))
+
+        # The render index of the previous scene is destroyed in the
+        # background, while the next scene is populated with the same
+        # render delegate.
+        cmds.file(f=1, new=1)
+        sphere = cmds.polySphere()[0]
+        sphereShape = cmds.listRelatives(sphere, shapes=1)[0]
+        assertShapesInIndex(sphereShape, ["pCubeShape"])
+
+        sceneDir = tempfile.mkdtemp()
+        self.addCleanup(shutil.rmtree, sceneDir)
+        scenePath = os.path.join(sceneDir, "sceneSwitch.ma")
+        cmds.file(rename=scenePath)
+        cmds.file(save=1, type="mayaAscii")
+        cmds.file(f=1, new=1)
+        cone = cmds.polyCone()[0]
+        assertShapesInIndex(
+            cmds.listRelatives(cone, shapes=1)[0], ["pSphereShape"])
+
+        cmds.file(scenePath, f=1, open=1)
+        activeEditor = cmds.playblast(ae=1)
+        cmds.modelEditor(
+            activeEditor, e=1,
+            rendererOverrideName="mtohRenderOverride_" + embree)
+        assertShapesInIndex(sphereShape, ["pConeShape"])
+
+        cmds.modelEditor(activeEditor, rendererOverrideName="", e=1)
+        cmds.refresh(f=1)
+        self.assertEqual(cmds.mtoh(listActiveRenderers=1), [])
+
+    def test_callbackStats(self):
+        cmds.file(f=1, new=1)
+        cmds.polyCube()
+        activeEditor = cmds.playblast(ae=1)
+        cmds.modelEditor(
+            activeEditor, e=1,
+            rendererOverrideName=hdmaya_test_utils.HD_STORM_OVERRIDE)
+        cmds.refresh(f=1)
+
+        stats = cmds.mtoh(callbackStats=hdmaya_test_utils.HD_STORM)
+        self.assertEqual(len(stats), 3)
+        self.assertEqual(stats[0], "active: true")
+        self.assertGreater(int(stats[1].split(": ")[1]), 0)
+        self.assertTrue(stats[2].startswith("callback invocations: "))
+
+        # Overrides not used by any panel register no callbacks.
+        cmds.modelEditor(activeEditor, rendererOverrideName="", e=1)
+        cmds.refresh(f=1)
+        stats = cmds.mtoh(callbackStats=hdmaya_test_utils.HD_STORM)
+        self.assertEqual(stats[0], "active: false")
+        self.assertEqual(stats[1], "callbacks: 0")
+
+    def test_refreshRenderSettings(self):
+        cmds.file(f=1, new=1)
+        cmds.mtoh(refreshRenderSettings=1)
+        self.assertTrue(mel.eval(
+            "exists mtohRenderOverride_HdEmbreeRendererPluginOptions"))
+        self.assertTrue(cmds.attributeQuery(
+            "HdEmbreeRendererPluginenableAmbientOcclusion",
+            node="defaultRenderGlobals", exists=1))
+
+    def test_adapterPlugins(self):
+        cmds.file(f=1, new=1)
+        cmds.polyCube()
+        activeEditor = cmds.playblast(ae=1)
+        cmds.modelEditor(
+            activeEditor, e=1,
+            rendererOverrideName=hdmaya_test_utils.HD_STORM_OVERRIDE)
+        cmds.refresh(f=1)
+
+        # The built-in adapters are loaded with hdmaya, and aren't listed.
+        plugins = cmds.mtoh(adapterPlugins=1)
+        for plugin in plugins:
+            self.assertNotIn("hdmaya:", plugin)
+        # The test adapter plugin declares that it handles locators, so it is
+        # only loaded once the scene has one.
+        self.assertIn("hdMayaTestAdapter: deferred", plugins)
+
+        cmds.spaceLocator()
+        cmds.refresh(f=1)
+        plugins = cmds.mtoh(adapterPlugins=1)
+        self.assertNotIn("hdMayaTestAdapter: deferred", plugins)
+        loaded = [
+            plugin for plugin in plugins
+            if plugin.startswith("hdMayaTestAdapter: loaded in ")]
+        self.assertEqual(len(loaded), 1)
+        self.assertTrue(loaded[0].endswith(" ms"))
+
+        cmds.modelEditor(activeEditor, rendererOverrideName="", e=1)
+        cmds.refresh(f=1)
+
+    def test_reuseUnchangedFrames(self):
+        cmds.file(f=1, new=1)
+        cube = cmds.polyCube()[0]
+        activeEditor = cmds.playblast(ae=1)
+        cmds.modelEditor(
+            activeEditor, e=1,
+            rendererOverrideName=hdmaya_test_utils.HD_STORM_OVERRIDE)
+        cmds.mtoh(createRenderGlobals=1)
+        cmds.setAttr("defaultRenderGlobals.mtohReuseUnchangedFrames", 1)
+        cmds.mtoh(updateRenderGlobals=1)
+        cmds.refresh(f=1)
+        cmds.refresh(f=1)
+
+        def reusedFrames():
+            stats = cmds.mtoh(refreshStats=hdmaya_test_utils.HD_STORM)
+            return int(stats[5].split(": ")[1])
+
+        reused = reusedFrames()
+        self.assertGreater(reused, 0)
+
+        # Nothing changed, so the frame is presented again.
+        cmds.refresh(f=1)
+        self.assertEqual(reusedFrames(), reused + 1)
+
+        cmds.setAttr(cube + ".translateX", 1)
+        cmds.refresh(f=1)
+        self.assertEqual(reusedFrames(), reused + 1)
+
+        camera = cmds.modelEditor(activeEditor, q=1, camera=1)
+        cmds.setAttr(camera + ".rotateY", 10)
+        cmds.refresh(f=1)
+        self.assertEqual(reusedFrames(), reused + 1)
+
+        cmds.setAttr("defaultRenderGlobals.mtohReuseUnchangedFrames", 0)
+        cmds.mtoh(updateRenderGlobals=1)
+        cmds.modelEditor(activeEditor, rendererOverrideName="", e=1)
+        cmds.refresh(f=1)
+
     # TODO: test_updateRenderGlobals
 
 
@@ -0,0 +1,141 @@
+import maya.cmds as cmds
+import maya.mel as mel
+
+import time
+import unittest
+
+import hdmaya_test_utils
+
+HD_EMBREE = "HdEmbreeRendererPlugin"
+HD_EMBREE_OVERRIDE = "mtohRenderOverride_" + HD_EMBREE
+
+
+def getSceneUpdates():
+    stats = cmds.mtoh(refreshStats=hdmaya_test_utils.HD_STORM)
+    for stat in stats:
+        if stat.startswith("scene updates: "):
+            return int(stat[len("scene updates: "):])
+    raise RuntimeError("scene updates missing from {!r}".format(stats))
+
+
+class TestMultiplePanels(unittest.TestCase):
+    REFRESHES = 20
+
+    def setUp(self):
+        cmds.file(f=1, new=1)
+        for i in range(100):
+            cube = cmds.polyCube()[0]
+            cmds.setAttr(cube + ".translate", i % 10, 0, i // 10)
+        mel.eval('setNamedPanelLayout "Four View"')
+        self.panels = [
+            panel for panel in cmds.getPanel(visiblePanels=1)
+            if cmds.getPanel(typeOf=panel) == "modelPanel"]
+        self.assertEqual(len(self.panels), 4)
+        for panel in self.panels:
+            cmds.modelEditor(
+                panel, e=1,
+                rendererOverrideName=hdmaya_test_utils.HD_STORM_OVERRIDE)
+        cmds.refresh(f=1)
+
+    def tearDown(self):
+        for panel in self.panels:
+            cmds.modelEditor(panel, e=1, rendererOverrideName="")
+        mel.eval('setNamedPanelLayout "Single Perspective View"')
+        cmds.refresh(f=1)
+
+    def test_sceneUpdatedOncePerRefresh(self):
+        sceneUpdates = getSceneUpdates()
+        for _ in range(self.REFRESHES):
+            cmds.refresh(f=1)
+        self.assertEqual(getSceneUpdates() - sceneUpdates, self.REFRESHES)
+
+    def test_editedSceneUpdatedOncePerRefresh(self):
+        sceneUpdates = getSceneUpdates()
+        for i in range(self.REFRESHES):
+            cmds.setAttr("pCube1.translateY", i * 0.1)
+            cmds.refresh(f=1)
+        self.assertEqual(getSceneUpdates() - sceneUpdates, self.REFRESHES)
+
+    def timeEditedRefreshes(self):
+        start = time.time()
+        for i in range(self.REFRESHES):
+            cmds.setAttr("pCube1.translateY", i * 0.1)
+            cmds.refresh(f=1)
+        return (time.time() - start) * 1000.0 / self.REFRESHES
+
+    def test_benchmarkOneAndFourPanels(self):
+        fourPanels = self.timeEditedRefreshes()
+        for panel in self.panels[1:]:
+            cmds.modelEditor(panel, e=1, rendererOverrideName="")
+        cmds.refresh(f=1)
+        onePanel = self.timeEditedRefreshes()
+        print("One panel: {:.2f} ms per refresh".format(onePanel))
+        print("Four panels: {:.2f} ms per refresh".format(fourPanels))
+        # The scene is only updated once for all panels, so the extra panels
+        # only add their draws.
+        self.assertLess(fourPanels, onePanel * len(self.panels))
+
+
+class TestRenderThreadPanels(unittest.TestCase):
+    TIMEOUT = 60.0
+
+    def setUp(self):
+        cmds.file(f=1, new=1)
+        cmds.polyCube()
+        cmds.mtoh(createRenderGlobals=1)
+        cmds.setAttr("defaultRenderGlobals.mtohRenderThread", 1)
+        cmds.mtoh(updateRenderGlobals=1)
+        mel.eval('setNamedPanelLayout "Two Panes Side by Side"')
+        self.panels = [
+            panel for panel in cmds.getPanel(visiblePanels=1)
+            if cmds.getPanel(typeOf=panel) == "modelPanel"]
+        self.assertEqual(len(self.panels), 2)
+        for panel in self.panels:
+            cmds.modelEditor(
+                panel, e=1, rendererOverrideName=HD_EMBREE_OVERRIDE)
+        cmds.refresh(f=1)
+
+    def tearDown(self):
+        for panel in self.panels:
+            cmds.modelEditor(panel, e=1, rendererOverrideName="")
+        mel.eval('setNamedPanelLayout "Single Perspective View"')
+        cmds.setAttr("defaultRenderGlobals.mtohRenderThread", 0)
+        cmds.mtoh(updateRenderGlobals=1)
+        cmds.refresh(f=1)
+
+    def waitForConvergence(self):
+        deadline = time.time() + self.TIMEOUT
+        while cmds.mtoh(refreshStats=HD_EMBREE)[0] != "converged: true":
+            self.assertLess(time.time(), deadline, "panels never converged")
+            cmds.refresh(f=1)
+            time.sleep(0.01)
+
+    def test_panelsConverge(self):
+        # Each panel presents the frames rendered for it, so the render
+        # thread doesn't restart the other panel's frame forever.
+        self.waitForConvergence()
+        self.assertEqual(
+            cmds.mtoh(refreshStats=HD_EMBREE)[1], "refresh interval: stopped")
+
+        camera = cmds.modelEditor(self.panels[0], q=1, camera=1)
+        cmds.setAttr(camera + ".rotateY", 10)
+        cmds.refresh(f=1)
+        self.assertEqual(
+            cmds.mtoh(refreshStats=HD_EMBREE)[0], "converged: false")
+        self.waitForConvergence()
+
+    def test_sceneEditedWhileRendering(self):
+        # Edits made while the render thread renders are applied once it
+        # finished.
+        cube = cmds.polyCube()[0]
+        cmds.refresh(f=1)
+        cmds.delete(cube)
+        cmds.refresh(f=1)
+        self.waitForConvergence()
+        self.assertFalse(any(
+            cube in rprim
+            for rprim in cmds.mtoh(listRenderIndex=HD_EMBREE)))
+
+
+if __name__ == "__main__":
+    unittest.main(argv=[""])
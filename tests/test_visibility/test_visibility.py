@@ -1,4 +1,5 @@
 import maya.cmds as cmds
+import maya.OpenMayaAnim as oma
 
 import unittest
 
@@ -146,6 +147,80 @@ class TestCommand(HdMayaTestCase):
 
         self.doHierarchicalVisibilityTest(makeNodeVis, makeNodeInvis, prep=prep)
 
+    def test_hideOnPlaybackWhileStopped(self):
+        # The playback profile only hides shapes during playback.
+        cmds.mtoh(createRenderGlobals=1)
+        cmds.setAttr("defaultRenderGlobals.mtohPlaybackProfile", True)
+        cmds.mtoh(updateRenderGlobals=1)
+        cmds.setAttr("{}.hideOnPlayback".format(self.cubeTrans), True)
+        cmds.refresh()
+        self.assertIn(
+            self.cubeRprim,
+            self.getVisibleIndex())
+
+        cmds.setAttr("defaultRenderGlobals.mtohPlaybackProfile", False)
+        cmds.mtoh(updateRenderGlobals=1)
+
+    def test_hideOnPlaybackDuringPlayback(self):
+        cmds.mtoh(createRenderGlobals=1)
+        cmds.setAttr("defaultRenderGlobals.mtohPlaybackProfile", True)
+        cmds.mtoh(updateRenderGlobals=1)
+        cmds.setAttr("{}.hideOnPlayback".format(self.cubeTrans), True)
+        cmds.refresh()
+        self.assertIn(
+            self.cubeRprim,
+            self.getVisibleIndex())
+
+        # Playback only advances once the script returns to the event loop,
+        # so the refreshes below render while Maya is playing.
+        cmds.play(state=True)
+        try:
+            self.assertTrue(oma.MAnimControl.isPlaying())
+            cmds.refresh()
+            self.assertNotIn(
+                self.cubeRprim,
+                self.getVisibleIndex())
+        finally:
+            cmds.play(state=False)
+
+        cmds.refresh()
+        self.assertIn(
+            self.cubeRprim,
+            self.getVisibleIndex())
+
+        cmds.setAttr("defaultRenderGlobals.mtohPlaybackProfile", False)
+        cmds.mtoh(updateRenderGlobals=1)
+
+    def test_hideOnPlaybackChangedDuringPlayback(self):
+        cmds.mtoh(createRenderGlobals=1)
+        cmds.setAttr("defaultRenderGlobals.mtohPlaybackProfile", True)
+        cmds.mtoh(updateRenderGlobals=1)
+
+        cmds.play(state=True)
+        try:
+            self.assertTrue(oma.MAnimControl.isPlaying())
+            cmds.refresh()
+            self.assertIn(
+                self.cubeRprim,
+                self.getVisibleIndex())
+
+            cmds.setAttr("{}.hideOnPlayback".format(self.cubeTrans), True)
+            cmds.refresh()
+            self.assertNotIn(
+                self.cubeRprim,
+                self.getVisibleIndex())
+
+            cmds.setAttr("{}.hideOnPlayback".format(self.cubeTrans), False)
+            cmds.refresh()
+            self.assertIn(
+                self.cubeRprim,
+                self.getVisibleIndex())
+        finally:
+            cmds.play(state=False)
+
+        cmds.setAttr("defaultRenderGlobals.mtohPlaybackProfile", False)
+        cmds.mtoh(updateRenderGlobals=1)
+
 
 if __name__ == "__main__":
     unittest.main(argv=[""])